@@ -3,36 +3,34 @@
  * @brief Този файл декларира функции, свързани с добавянето на нови имоти в системата.
  *
  * Той включва функционалности за добавяне на единични или множество имоти,
- * обработка на валидиране на потребителски вход за различни атрибути на имота,
- * и проверка на лимитите за капацитет на системата.
+ * обработка на валидиране на потребителски вход за различни атрибути на имота
+ * и санитизация на текстовите полета.
  */
 
 #ifndef ADD_H
 #define ADD_H
 
 #include "structs.h" 
+#include "store.h"
 #include <limits>    
 #include <iostream>  
 
 /**
  * @brief Ръководи потребителя при добавяне на единичен нов имот в системата.
- * @param properties Масив от структури Property, където ще бъде добавен новият имот.
- * @param propertyCount Референция към цяло число, представляващо текущия брой имоти.
+ * @param store Контейнерът с имоти, в който ще бъде добавен новият имот.
  *
  * Тази функция подканва потребителя за всички необходими детайли на имота,
- * валидира входа и добавя имота към масива `properties`.
+ * валидира входа и добавя имота в `store`.
  */
-void addSingleProperty(Property properties[], int& propertyCount);
+void addSingleProperty(PropertyStore& store);
 
 /**
  * @brief Позволява на потребителя да добавя множество имоти в системата в една сесия.
- * @param properties Масив от структури Property, където ще бъдат добавени новите имоти.
- * @param propertyCount Референция към цяло число, представляващо текущия брой имоти.
+ * @param store Контейнерът с имоти, в който ще бъдат добавени новите имоти.
  *
- * Тази функция многократно извиква `addSingleProperty`, докато потребителят не реши да спре
- * или докато не бъде достигнат максималният капацитет.
+ * Тази функция многократно извиква `addSingleProperty` за броя имоти, посочен от потребителя.
  */
-void addMultipleProperties(Property properties[], int& propertyCount);
+void addMultipleProperties(PropertyStore& store);
 
 /**
  * @brief Шаблонна функция за получаване на валидиран числов вход от потребителя.
@@ -63,15 +61,6 @@ template <typename T> T getValidNumericInput(const char* prompt, const char* err
     }
 }
 
-/**
- * @brief Проверява дали е достигнат максималният брой имоти.
- * @param propertyCount Текущият брой имоти в системата.
- * @return true, ако капацитетът е достигнат, в противен случай false.
- *
- * Предотвратява препълване на буфера и гарантира, че приложението работи в рамките на определените лимити.
- */
-bool isCapacityReached(int propertyCount);
-
 /**
  * @brief Санитизира C-стил низ, като премахва водещи/следващи интервали и заменя
  *        множество вътрешни интервали с един интервал.
@@ -81,6 +70,16 @@ bool isCapacityReached(int propertyCount);
  */
 void sanitizeString(char* str);
 
+/**
+ * @brief Проверява дали цена или площ е крайно неотрицателно число.
+ * @param value Стойността за проверка.
+ * @return false за отрицателна стойност, `nan` и `inf`.
+ *
+ * Използва се при импортиране и в пакетния режим, където числата се разчитат
+ * с `from_chars`, който за разлика от `cin` приема `nan` и `inf`.
+ */
+bool isValidMeasure(double value);
+
 /**
  * @brief Подканва потребителя за въвеждане на низ и го съхранява в буфер, със санитизация.
  * @param prompt Съобщението, показвано на потребителя при поискване на вход.
@@ -0,0 +1,149 @@
+/**
+ * @file aggregate.h
+ * @brief Този файл декларира генератора на отчети с групиране по произволни полета и обобщени стойности.
+ *
+ * Отчетът се описва с полетата за групиране (брокер, район, тип, изложение, статус, брой стаи)
+ * и със списък от показатели (брой, сума, средно, минимум, максимум, стандартно отклонение,
+ * медиана, 90-и и 99-и персентил) върху числово поле (цена, обща площ, етаж, брой стаи,
+ * продаден, цена на кв.м.). Така „средна цена по тип и район“, „дял продадени по изложение“ или „минимален и максимален етаж по брокер“ са
+ * различни описания на един и същ отчет, изчислен с едно обхождане на колоните.
+ */
+
+#ifndef AGGREGATE_H
+#define AGGREGATE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "structs.h"
+#include "store.h"
+
+/**
+ * @brief Полета, по които могат да се групират имотите.
+ */
+enum GroupField {
+    GROUP_BROKER,
+    GROUP_AREA,
+    GROUP_TYPE,
+    GROUP_EXPOSITION,
+    GROUP_STATUS,
+    GROUP_ROOMS,
+    GROUP_FIELD_COUNT
+};
+
+/**
+ * @brief Числови полета, върху които се изчисляват показателите.
+ *
+ * `MEASURE_SOLD` е 1 за продаден имот и 0 за останалите, така че средното му е делът на продадените.
+ * `MEASURE_PRICE_PER_SQM` е цената на квадратен метър; имотите без положителна площ не участват
+ * в показателите върху него (но се броят в `METRIC_COUNT`).
+ */
+enum MeasureField {
+    MEASURE_PRICE,
+    MEASURE_TOTAL_AREA,
+    MEASURE_FLOOR,
+    MEASURE_ROOMS,
+    MEASURE_SOLD,
+    MEASURE_PRICE_PER_SQM,
+    MEASURE_FIELD_COUNT
+};
+
+/**
+ * @brief Видове показатели за група.
+ *
+ * Медианата и персентилите са приблизителни: изчисляват се със скица `QuantileSketch`
+ * за всяка група, без сортиране на стойностите.
+ */
+enum Metric {
+    METRIC_COUNT,
+    METRIC_SUM,
+    METRIC_AVERAGE,
+    METRIC_MIN,
+    METRIC_MAX,
+    METRIC_STDDEV,
+    METRIC_MEDIAN,
+    METRIC_P90,
+    METRIC_P99,
+    METRIC_COUNT_ALL
+};
+
+/**
+ * @brief Един показател в отчета: вид и поле (полето не се използва за `METRIC_COUNT`).
+ */
+struct MetricSpec {
+    Metric metric;
+    MeasureField field;
+};
+
+/**
+ * @brief Описание на отчет: полета за групиране и показатели.
+ */
+struct GroupReportSpec {
+    std::vector<GroupField> groupBy;
+    std::vector<MetricSpec> metrics;
+};
+
+/**
+ * @brief Ред от отчета: стойностите на полетата за групиране и на показателите.
+ *
+ * `keys[i]` е идентификаторът в речника за текстовите полета, стойността на `Status`
+ * за статуса и броят стаи за `GROUP_ROOMS`. `values[i]` отговаря на `metrics[i]` от описанието.
+ */
+struct GroupReportRow {
+    std::vector<int64_t> keys;
+    std::vector<double> values;
+};
+
+/**
+ * @brief Брой групи, до който ключът на групата се използва директно като индекс в масив.
+ *
+ * При повече възможни комбинации съществуващите комбинации първо се номерират с хеш таблица.
+ */
+const int64_t DENSE_GROUP_LIMIT = 1 << 16;
+
+/**
+ * @brief Изчислява отчет с групиране върху всички имоти в контейнера.
+ * @param store Контейнерът с имоти.
+ * @param spec Описанието на отчета.
+ * @param threadCount Брой нишки; 0 избира автоматично (паралелно над `PARALLEL_GROUP_THRESHOLD` имота).
+ * @return Редовете за непразните групи, подредени по полетата за групиране (текстовите - по азбучен ред).
+ *
+ * Ключът на групата се изчислява за всички имоти колона по колона, след което всички показатели
+ * се натрупват с едно обхождане чрез `groupByDenseKey`. За квантилните показатели се прави
+ * по едно допълнително обхождане за всяко числово поле, в което всяка нишка натрупва скици
+ * за своя дял от редовете, а скиците се сливат накрая. Без полета за групиране резултатът е един
+ * ред за целия каталог (ако той не е празен).
+ */
+std::vector<GroupReportRow> buildGroupReport(const PropertyStore& store, const GroupReportSpec& spec, int threadCount = 0);
+
+/**
+ * @brief Връща текстовата стойност на ключ от ред на отчета (име от речника, статус или брой стаи).
+ * @param store Контейнерът, от чиито речници е изчислен отчетът.
+ * @param field Полето за групиране.
+ * @param key Стойността на ключа.
+ * @param localized true за преведено име на статуса, false за `available`/`reserved`/`sold`.
+ */
+std::string groupKeyText(const PropertyStore& store, GroupField field, int64_t key, bool localized);
+
+/**
+ * @brief Разчита име на поле за групиране (`broker`, `area`, `type`, `exposition`, `status`, `rooms`).
+ * @return true, ако името е познато.
+ */
+bool parseGroupField(const std::string& name, GroupField& field);
+
+/**
+ * @brief Разчита показател във вида `count` или `<показател>:<поле>`, например `avg:price`.
+ *
+ * Показатели: `count`, `sum`, `avg`, `min`, `max`, `stddev`, `median`, `p90`, `p99`; полета: `price`, `totalArea`,
+ * `floor`, `rooms`, `sold`, `pricePerSqm`.
+ * @return true, ако текстът е валиден показател.
+ */
+bool parseMetricSpec(const std::string& text, MetricSpec& spec);
+
+/**
+ * @brief Връща краткото име на показател, например `avg(price)` или `count`.
+ */
+std::string metricSpecName(const MetricSpec& spec);
+
+#endif
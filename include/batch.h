@@ -0,0 +1,61 @@
+/**
+ * @file batch.h
+ * @brief Този файл декларира пакетния (неинтерактивен) режим на приложението.
+ *
+ * В пакетния режим командите се четат ред по ред от файл или от стандартния вход и се
+ * изпълняват директно върху контейнера с имоти, без менюта, изчистване на конзолата и преводи.
+ * Резултатът е предназначен за машинна обработка:
+ * - `ROW <запис>` - имот във формата на `sync.txt`;
+ * - `BROKER <име>|<общо>|<продадени>|<процент>` - ред от отчета по брокери;
+ * - `GROUP <ключ>|...|<показател>|...` - ред от отчет с групиране;
+ * - `OK <команда> [ключ=стойност ...]` - успешно изпълнена команда;
+ * - `ERR <ред> <код>` - неуспешна команда (кодове: `syntax`, `unknown_command`, `not_found`,
+ *   `duplicate_ref`, `sold_readonly`, `bad_value`, `io`, `mismatch`);
+ * - `DONE commands=<брой> errors=<брой> seconds=<време> ops_per_sec=<брой>` - в края на скрипта.
+ *
+ * Поддържани команди (празни редове и редове, започващи с `#`, се пропускат):
+ * - `add <запис>` - запис във формата на `sync.txt` (10 полета, разделени с |);
+ * - `update <реф. номер> <поле> <стойност>` - полета: ref, broker, type, area, exposition,
+ *   price, totalArea, rooms, floor, status (available/reserved/sold или 0-2);
+ * - `delete <реф. номер>`, `clear`, `get <реф. номер>`, `count`, `list`;
+ * - `search broker <име>` (по цена възходящо), `search rooms <брой>` (по цена низходящо);
+ * - `search range <поле> <мин> <макс> [<поле> <мин> <макс> ...]` - полета: price, totalArea,
+ *   floor, rooms; затворени интервали, `*` за липсваща граница; по цена възходящо;
+ * - `search where <израз>` - условия `<поле> <оператор> <стойност>`, съчетани с `and`, `or`
+ *   и скоби; текстовите полета (broker, type, area, exposition) и status допускат само `=`,
+ *   а price, totalArea, floor, rooms - `=`, `<`, `<=`, `>`, `>=`; текст с интервали се огражда
+ *   с двойни кавички; по цена възходящо;
+ * - `sort <поле> asc|desc [<поле> asc|desc ...] [stable]` - до 4 критерия по приоритет; полета като
+ *   при `update`; `stable` запазва реда в каталога на имотите, равни по всички критерии;
+ * - `report expensive <район>`, `report average <район>` (брой, сума, средна и точна медианна
+ *   цена), `report sold-by-broker`;
+ * - `report top-expensive <K> <район>`, `report top-largest <K>`, `report top-cheapest-sqm <K>` -
+ *   първите K имота по цена (низходящо), по обща площ (низходящо) и по цена на кв.м. (възходящо);
+ * - `report group <полета> <показатели>` - отчет с групиране: полета broker, area, type, exposition,
+ *   status, rooms, разделени със запетая (`-` без групиране); показатели `count` или
+ *   `<sum|avg|min|max|stddev|median|p90|p99>:<price|totalArea|floor|rooms|sold|pricePerSqm>`,
+ *   разделени със запетая (медианата и персентилите са приблизителни);
+ * - `report sqm-outliers <N>` - имотите с цена на кв.м. на повече от N стандартни отклонения
+ *   от средната за района им, като редове `OUTLIER <реф. номер>|<район>|<цена на кв.м.>|<отклонение>`;
+ * - `report all-areas [name|count|average|max] [<път>]` - брой, сума, средна и най-висока цена
+ *   за всички райони с едно обхождане, като редове `AREA <район>|<брой>|<сума>|<средна>|<най-висока>|<реф. номер>`
+ *   на стандартния изход или във файла `<път>`;
+ * - `import <път>` - масов импорт чрез `importProperties`;
+ * - `save` - контролна точка на файловете за възстановяване; `save <път>` - двоичен файл;
+ * - `verify` - проверка на обобщените стойности по райони спрямо изчислени наново (`mismatch` при разлика).
+ *
+ * При стартиране се зареждат данните от файловете за възстановяване, а промените
+ * се записват в журнала по същия начин, както в интерактивния режим.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+/**
+ * @brief Изпълнява скрипт с команди в пакетен режим.
+ * @param scriptPath Пътят до скрипта или "-" за четене от стандартния вход.
+ * @return Код за изход на процеса: 0 при успех, 1 при поне една неуспешна команда, 2 ако скриптът не може да бъде отворен.
+ */
+int runBatchScript(const char* scriptPath);
+
+#endif
@@ -0,0 +1,30 @@
+/**
+ * @file bench.h
+ * @brief Този файл декларира вградените сравнителни тестове за производителност.
+ *
+ * Тестовете се стартират с `real_estate_agency --bench <име> [брой]` и работят върху
+ * случайно генерирани данни, без да четат или променят файловете на приложението.
+ * Всеки размер се отпечатва като един ред `BENCH <име> n=<брой> ...` с времената
+ * на сравняваните варианти в милисекунди. Без `[брой]` се използват 10^5, 10^6 и 10^7 записа.
+ *
+ * Налични тестове:
+ * - `sort` - сортиране на позиции по цена последователно и на няколко нишки (`parallelSort`);
+ * - `radix` - сортиране чрез сравнения срещу поразрядно сортиране (`radixSortSlots`) по цена и брой стаи;
+ * - `group` - статистика по брокери чрез `std::map` с низове срещу `groupByDenseKey` на една и на няколко нишки;
+ * - `sqm` - скаларните срещу векторизираните ядра за цена на кв.м. и за отклонения от средното на района;
+ * - `index` - масово зареждане на PropertyStore и редуване на единично добавяне с търсене по индексите,
+ *   последвано от проверка на всички индекси след случайни добавяния, промени и изтривания.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+/**
+ * @brief Изпълнява сравнителен тест.
+ * @param name Името на теста.
+ * @param countText Броят на записите като текст или `NULL` за размерите по подразбиране.
+ * @return Код за изход на процеса: 0 при успех, 1 при несъвпадащи резултати, 2 при непознат тест или невалиден брой.
+ */
+int runBenchmark(const char* name, const char* countText);
+
+#endif
@@ -10,25 +10,24 @@
 #define DELETE_H
 
 #include "structs.h" 
+#include "store.h"
 
 /**
  * @brief Изтрива един имот от системата въз основа на неговия референтен номер.
- * @param properties Масив от структури Property, от които да се изтрива.
- * @param propertyCount Референция към цяло число, представляващо текущия брой имоти.
+ * @param store Контейнерът с имоти, от който да се изтрива.
  *
  * Подканва потребителя за референтен номер на имот, потвърждава изтриването
- * и след това измества елементите на масива, за да запази последователността.
+ * и след това премахва имота, като запазва реда на останалите.
  */
-void DeleteProperty(Property properties[], int& propertyCount);
+void DeleteProperty(PropertyStore& store);
 
 /**
  * @brief Изтрива всички имоти, съхранени в момента в системата.
- * @param properties Масив от структури Property, които да бъдат изчистени.
- * @param propertyCount Референция към цяло число, представляващо текущия брой имоти.
+ * @param store Контейнерът с имоти, който да бъде изчистен.
  *
  * Изисква изрично потвърждение от потребителя, за да се предотврати случайна загуба на данни.
  * Ефективно нулира списъка с имоти до празно състояние.
  */
-void DeleteAllProperties(Property properties[], int& propertyCount);
+void DeleteAllProperties(PropertyStore& store);
 
 #endif 
@@ -0,0 +1,62 @@
+/**
+ * @file dictionary.h
+ * @brief Този файл декларира речник за кодиране на повтарящи се текстови стойности с числови идентификатори.
+ *
+ * Текстовите полета на имотите (брокер, тип, район, изложение) имат малък брой различни
+ * стойности. Речникът съхранява всяка стойност веднъж, а записите пазят само нейния
+ * 32-битов идентификатор, така че сравненията стават целочислени.
+ */
+
+#ifndef DICTIONARY_H
+#define DICTIONARY_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief Речник, който съпоставя уникални низове с последователни идентификатори от 0 нагоре.
+ *
+ * Идентификаторите са стабилни до извикване на `clear`. Низовете се пазят в `std::deque`,
+ * затова указателите, върнати от `lookup`, остават валидни при добавяне на нови стойности.
+ */
+class StringDictionary {
+public:
+    /**
+     * @brief Връща идентификатора на низа, като го добавя в речника, ако още не присъства.
+     * @param value Низът за кодиране.
+     * @return Идентификаторът на низа.
+     */
+    uint32_t intern(const char* value);
+
+    /**
+     * @brief Търси идентификатора на низ, без да го добавя.
+     * @param value Търсеният низ.
+     * @return Идентификаторът на низа или -1, ако низът не присъства в речника.
+     */
+    int64_t find(const char* value) const;
+
+    /**
+     * @brief Връща низа, съответстващ на даден идентификатор.
+     * @param id Идентификатор, получен от `intern`.
+     * @return C-стил низ, валиден до извикване на `clear`.
+     */
+    const char* lookup(uint32_t id) const;
+
+    /**
+     * @brief Връща броя на различните низове в речника.
+     */
+    int size() const;
+
+    /**
+     * @brief Премахва всички низове от речника.
+     */
+    void clear();
+
+private:
+    std::deque<std::string> values;
+    std::unordered_map<std::string, uint32_t> ids;
+};
+
+#endif
@@ -11,44 +11,51 @@
 #define DISPLAY_H
 
 #include "structs.h" 
+#include "store.h"
 
 /**
  * @brief Показва всички имоти, които в момента са съхранени в системата.
- * @param properties Масив от структури Property за показване.
- * @param propertyCount Броят на имотите в масива.
+ * @param store Контейнерът с имоти за показване.
  *
  * Тази функция итерира през целия списък с имоти и извиква
  * `displayPropertyDetails` за всеки от тях.
  */
-void displayAllProperties(const Property properties[], int propertyCount);
+void displayAllProperties(const PropertyStore& store);
 
 /**
  * @brief Показва само имотите, които са маркирани като ПРОДАДЕНИ.
- * @param properties Масив от структури Property за филтриране и показване.
- * @param propertyCount Броят на имотите в масива.
+ * @param store Контейнерът с имоти за филтриране и показване.
  *
  * Това помага на потребителите бързо да идентифицират имоти, които вече не са налични.
  */
-void displaySoldProperties(const Property properties[], int propertyCount);
+void displaySoldProperties(const PropertyStore& store);
 
 /**
  * @brief Показва имотите, сортирани по тяхната обща площ в низходящ ред.
- * @param properties Масив от структури Property за сортиране и показване.
- * @param propertyCount Броят на имотите в масива.
+ * @param store Контейнерът с имоти за сортиране и показване.
  *
  * Тази функция обикновено прави временно копие за сортиране, без да променя оригиналния ред,
  * след което показва детайлите на най-големите имоти.
  */
-void displayLargestProperties(const Property properties[], int propertyCount);
+void displayLargestProperties(const PropertyStore& store);
 
 /**
  * @brief Показва подробната информация за един имот.
- * @param prop Постоянна референция към структурата Property за показване.
+ * @param prop Изглед към имота за показване; структура `Property` се преобразува автоматично.
  *
  * Това е помощна функция, използвана от други функции за показване, за да осигури последователно
  * форматиране на детайлите на имота.
  */
-void displayPropertyDetails(const Property& prop);
+void displayPropertyDetails(const PropertyView& prop);
+
+/**
+ * @brief Показва имотите на дадените позиции в реда на позициите, с пореден номер пред всеки.
+ * @param store Контейнерът с имоти.
+ * @param slots Позициите за показване, например резултатът от търсене.
+ *
+ * Имотите се четат направо от контейнера чрез `PropertyStore::view`, без да се копират.
+ */
+void displayPropertyList(const PropertyStore& store, SlotSpan slots);
 
 /**
  * @brief Проверява дали в системата са заредени имоти.
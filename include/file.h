@@ -10,68 +10,107 @@
 #ifndef FILE_H
 #define FILE_H
 
+#include <cstdio>
+
 #include "structs.h" 
+#include "store.h"
 
 /**
- * @brief Записва текущия масив от имоти в двоичен файл.
- * @param properties Постоянен масив от структури Property за запис.
- * @param propertyCount Броят на имотите в масива.
+ * @brief Записва текущите имоти в двоичен файл.
+ * @param store Контейнерът с имоти за запис.
  *
  * Тази функция сериализира данни за имоти в двоичен формат за ефективно съхранение
  * и извличане, обикновено използвано за основния файл с данни.
  */
-void saveToBinaryFile(const Property properties[], int propertyCount);
+void saveToBinaryFile(const PropertyStore& store);
 
 /**
  * @brief Зарежда имоти от двоичен файл в паметта на приложението.
- * @param properties Масив от структури Property, където ще бъдат съхранени заредените данни.
- * @param propertyCount Референция към цяло число, което ще съхранява броя на заредените имоти.
+ * @param store Контейнерът, в който ще бъдат заредени имотите.
  *
- * Десериализира данни за имоти от двоичен файл, попълвайки масива `properties`
- * и актуализирайки `propertyCount`. Това обикновено се извиква при стартиране на приложението.
+ * Десериализира данни за имоти от двоичен файл, попълвайки контейнера `store`.
  */
-void loadFromBinaryFile(Property properties[], int& propertyCount);
+void loadFromBinaryFile(PropertyStore& store);
 
 /**
- * @brief Записва текущия масив от имоти в двоичен файл за възстановяване.
- * @param properties Постоянен масив от структури Property за запис.
- * @param propertyCount Броят на имотите в масива.
+ * @brief Записва текущите имоти в двоичен файл за възстановяване.
+ * @param store Контейнерът с имоти за запис.
  *
  * Тази функция създава резервно копие на данните за имоти в двоичен формат,
  * което може да се използва за възстановяване на данни в случай на неочаквано прекратяване на приложението
  * или повреда на данните.
+ * @return true, ако файлът е записан, в противен случай false.
+ */
+bool saveToRecoveryBinaryFile(const PropertyStore& store);
+
+/**
+ * @brief Записва всички имоти в двоичен файл на указан път, без потребителско взаимодействие.
+ * @param path Пътят до файла, който се създава или презаписва.
+ * @param store Контейнерът с имоти за запис.
+ * @return true, ако файлът е записан, в противен случай false.
+ *
+ * Записът минава през временен файл, така че при грешка съществуващият файл остава непокътнат.
  */
-void saveToRecoveryBinaryFile(const Property properties[], int propertyCount);
+bool writeBinaryFile(const char* path, const PropertyStore& store);
 
 /**
- * @brief Записва текущия масив от имоти в четим текстов файл.
- * @param properties Постоянен масив от структури Property за запис.
- * @param propertyCount Броят на имотите в масива.
+ * @brief Записва текущите имоти в четим текстов файл.
+ * @param store Контейнерът с имоти за запис.
  *
  * Тази функция експортира данни за имоти във форматиран текстов файл, което го прави
  * лесен за потребителите да преглеждат или споделят данните извън приложението.
  */
-void saveToUserFriendlyTextFile(const Property properties[], int propertyCount);
+void saveToUserFriendlyTextFile(const PropertyStore& store);
 
 /**
- * @brief Записва текущия масив от имоти в обикновен текстов файл за цели на синхронизация.
- * @param properties Постоянен масив от структури Property за запис.
- * @param propertyCount Броят на имотите в масива.
+ * @brief Записва текущите имоти в обикновен текстов файл за цели на синхронизация.
+ * @param store Контейнерът с имоти за запис.
  *
  * Този файлов формат обикновено е по-опростен от удобния за потребителя и може да бъде оптимизиран
  * за програмно анализиране по време на процесите на синхронизация на данни.
+ * @return true, ако файлът е записан изцяло, в противен случай false.
  */
-void saveToSyncTextFile(const Property properties[], int propertyCount);
+bool saveToSyncTextFile(const PropertyStore& store);
 
 /**
  * @brief Зарежда имоти от обикновен текстов файл за синхронизация в паметта на приложението.
- * @param properties Масив от структури Property, където ще бъдат съхранени заредените данни.
- * @param propertyCount Референция към цяло число, което ще съхранява броя на заредените имоти.
+ * @param store Контейнерът, в който ще бъдат заредени имотите.
  *
  * Използва се за импортиране на данни за имоти от текстов файл за синхронизация, анализиране на съдържанието му
  * и актуализиране на списъка с имоти в паметта.
  */
-void loadFromSyncTextFile(Property properties[], int& propertyCount);
+void loadFromSyncTextFile(PropertyStore& store);
+
+/**
+ * @brief Източник, от който `readRecoveryFiles` е заредил данните.
+ */
+enum RecoverySource { RECOVERY_NONE, RECOVERY_CHECKPOINT, RECOVERY_SYNC_TEXT };
+
+/**
+ * @brief Зарежда данните от последната сесия, без да пита потребителя.
+ * @param store Контейнерът, който ще бъде попълнен.
+ * @return Източникът на данните: контролна точка с журнал, `sync.txt` или нищо.
+ *
+ * Използва се от пакетния режим, както и от `loadFromRecoveryFiles`.
+ */
+RecoverySource readRecoveryFiles(PropertyStore& store);
+
+/**
+ * @brief Зарежда данните от последната сесия от файловете за възстановяване.
+ * @param store Контейнерът, в който ще бъдат заредени имотите.
+ *
+ * Зарежда контролната точка от `sync.dat` и прилага върху нея журнала на промените.
+ * Ако `sync.dat` липсва или е повреден, използва `sync.txt` чрез `loadFromSyncTextFile`.
+ * Преди зареждане потребителят потвърждава възстановяването.
+ */
+void loadFromRecoveryFiles(PropertyStore& store);
+
+/**
+ * @brief Записва един имот като ред във формата на `sync.txt`.
+ * @param file Отворен за запис текстов файл.
+ * @param property Изглед към имота за запис; структура `Property` се преобразува автоматично.
+ */
+void writeSyncRecord(FILE* file, const PropertyView& property);
 
 /**
  * @brief Подканва потребителя за потвърждение преди презаписване на съществуващ файл.
@@ -83,13 +122,14 @@ void loadFromSyncTextFile(Property properties[], int& propertyCount);
 bool confirmOverwrite(const char* filename);
 
 /**
- * @brief Синхронизира данните за имоти с файловете за възстановяване (както двоични, така и текстови).
- * @param properties Постоянен масив от структури Property за синхронизация.
- * @param propertyCount Броят на имотите в масива.
+ * @brief Прави контролна точка: записва целия каталог във файловете за възстановяване и изчиства журнала.
+ * @param store Контейнерът с имоти за синхронизация.
  *
- * Тази функция гарантира, че резервните файлове и файловете за синхронизация са актуални
- * с текущото състояние на данните за имоти, осигурявайки множество слоеве за безопасност на данните.
+ * Единичните промени се записват в журнала (`journal.h`); тази функция се извиква при операции,
+ * които променят целия каталог (сортиране, зареждане), при изход и периодично от самия журнал.
+ * Ако `sync.dat` не може да бъде записан, журналът не се изчиства.
+ * @return true, ако контролната точка е записана, в противен случай false.
  */
-void syncDataToRecoveryFiles(const Property properties[], int propertyCount);
+bool syncDataToRecoveryFiles(const PropertyStore& store);
 
 #endif
@@ -0,0 +1,106 @@
+/**
+ * @file group.h
+ * @brief Този файл дефинира групирането на имоти по ключ с натрупване на обобщени стойности.
+ *
+ * Ключовете на групите са плътни идентификатори (например от речниците на PropertyStore),
+ * затова състоянието на всяка група се пази в обикновен масив, индексиран с ключа,
+ * вместо в `std::map` с низове. Натрупването е един плътен цикъл по колоните.
+ * При голям брой редове всяка нишка натрупва частични стойности за своя дял от редовете
+ * в собствен масив, а накрая частичните масиви се сливат. Броят на нишките се ограничава
+ * според броя на групите, така че частичните масиви да не заемат повече памет и време
+ * за сливане, отколкото спестява паралелното натрупване.
+ */
+
+#ifndef GROUP_H
+#define GROUP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Брой редове, над който групирането се разделя между няколко нишки.
+ */
+const size_t PARALLEL_GROUP_THRESHOLD = 256 * 1024;
+
+/**
+ * @brief Най-голям общ размер в байтове на частичните масиви на всички нишки при групиране.
+ */
+const size_t PARALLEL_GROUP_MEMORY_LIMIT = 32 * 1024 * 1024;
+
+/**
+ * @brief Избира броя на нишките за групиране на `rowCount` реда в `groupCount` групи.
+ * @param stateSize Размерът в байтове на състоянието на една група.
+ * @param threadCount Желаният брой нишки; 0 избира автоматично.
+ * @return 1 под `PARALLEL_GROUP_THRESHOLD`, иначе броя на ядрата (или `threadCount`, ако е зададен),
+ * ограничен така, че всяка нишка да обработва поне толкова редове, колкото са групите,
+ * и частичните масиви общо да не надхвърлят `PARALLEL_GROUP_MEMORY_LIMIT`.
+ */
+inline int chooseGroupThreadCount(size_t rowCount, size_t groupCount, size_t stateSize, int threadCount) {
+    if (threadCount <= 0) {
+        if (rowCount < PARALLEL_GROUP_THRESHOLD) {
+            return 1;
+        }
+        threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    groupCount = std::max<size_t>(1, groupCount);
+    size_t limit = std::min(rowCount / groupCount, PARALLEL_GROUP_MEMORY_LIMIT / (groupCount * stateSize));
+    return (int)std::max<size_t>(1, std::min((size_t)threadCount, limit));
+}
+
+/**
+ * @brief Групира редовете `[0, rowCount)` по плътен ключ и натрупва състояние за всяка група.
+ * @param keys Колона с ключа на всеки ред; стойностите са в `[0, groupCount)`.
+ * @param rowCount Броят на редовете.
+ * @param groupCount Броят на възможните ключове.
+ * @param accumulate Функция `accumulate(State& group, int row)`, която добавя ред към групата си.
+ * @param threadCount Брой нишки; 0 избира автоматично според броя на редовете и ядрата.
+ * @return Състоянието на всяка група, индексирано с ключа.
+ *
+ * `State` трябва да има конструктор по подразбиране, създаващ празна група, и оператор `+=`,
+ * който слива две частични състояния. В паралелния режим всяка нишка обработва непрекъснат
+ * дял от редовете в собствен масив от състояния, така че нишките не пишат в обща памет;
+ * частичните масиви се сливат последователно след края на нишките. Броят на нишките
+ * се ограничава чрез `chooseGroupThreadCount` според броя на групите.
+ */
+template <typename State, typename Accumulate>
+std::vector<State> groupByDenseKey(const uint32_t* keys, int rowCount, size_t groupCount, Accumulate accumulate,
+                                   int threadCount = 0) {
+    threadCount = chooseGroupThreadCount(std::max(0, rowCount), groupCount, sizeof(State), threadCount);
+    if (threadCount <= 1) {
+        std::vector<State> groups(groupCount);
+        for (int row = 0; row < rowCount; row++) {
+            accumulate(groups[keys[row]], row);
+        }
+        return groups;
+    }
+
+    std::vector<std::vector<State>> partials(threadCount, std::vector<State>(groupCount));
+    std::vector<std::thread> workers;
+    int chunkSize = (rowCount + threadCount - 1) / threadCount;
+    for (int part = 0; part < threadCount; part++) {
+        int begin = std::min(rowCount, part * chunkSize);
+        int end = std::min(rowCount, begin + chunkSize);
+        workers.emplace_back([&partials, &accumulate, keys, part, begin, end]() {
+            std::vector<State>& groups = partials[part];
+            for (int row = begin; row < end; row++) {
+                accumulate(groups[keys[row]], row);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    std::vector<State>& groups = partials[0];
+    for (int part = 1; part < threadCount; part++) {
+        for (size_t group = 0; group < groupCount; group++) {
+            groups[group] += partials[part][group];
+        }
+    }
+    return std::move(groups);
+}
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * @file import.h
+ * @brief Този файл декларира функции за масово импортиране на обяви от CSV файлове и файлове, разделени с | (pipe).
+ *
+ * Импортирането не изисква въвеждане поле по поле: файлът се обхожда ред по ред, всеки ред
+ * се валидира със същите правила като ръчното въвеждане, а валидните имоти се добавят
+ * директно в контейнера. Файловете за възстановяване се обновяват веднъж, в края на импорта.
+ */
+
+#ifndef IMPORT_H
+#define IMPORT_H
+
+#include <vector>
+
+#include "store.h"
+
+/**
+ * @brief Максимален брой отхвърлени редове, за които се показва подробно съобщение.
+ */
+const int IMPORT_MAX_REPORTED_ERRORS = 10;
+
+/**
+ * @brief Причина за отхвърляне на ред при импортиране.
+ */
+enum ImportRejectReason { IMPORT_BAD_FIELD_COUNT, IMPORT_BAD_NUMBER, IMPORT_EMPTY_TEXT, IMPORT_DUPLICATE_REF };
+
+/**
+ * @brief Отхвърлен ред: номер на реда във файла (от 1) и причина.
+ */
+struct ImportRejectedRow {
+    int lineNumber;
+    ImportRejectReason reason;
+};
+
+/**
+ * @brief Резултат от импортиране на файл.
+ */
+struct ImportResult {
+    bool opened = false;
+    int rowsRead = 0;
+    int imported = 0;
+    int rejected = 0;
+    double seconds = 0.0;
+    std::vector<ImportRejectedRow> rejectedRows;
+};
+
+/**
+ * @brief Импортира имоти от файл в контейнера, без да обновява файловете за възстановяване.
+ * @param path Пътят до файла.
+ * @param store Контейнерът, в който се добавят имотите.
+ * @return Статистика за импорта; първите `IMPORT_MAX_REPORTED_ERRORS` отхвърлени реда са в `rejectedRows`.
+ *
+ * Всеки ред съдържа полетата референтен номер, брокер, тип, район, изложение, цена, обща площ,
+ * стаи, етаж и по избор статус (0 - продаден, 1 - резервиран, 2 - наличен; по подразбиране наличен).
+ * Разделителят (`|` или `,`) се определя по първия ред, а ред със заглавия на колоните се пропуска.
+ * Полетата в CSV могат да бъдат оградени с кавички. Редове с повтарящ се референтен номер
+ * (спрямо контейнера или по-ранен ред във файла) се отхвърлят.
+ */
+ImportResult importProperties(const char* path, PropertyStore& store);
+
+/**
+ * @brief Подканва потребителя за път до файл, импортира го и показва статистиката.
+ * @param store Контейнерът, в който се добавят имотите.
+ *
+ * След успешен импорт файловете за възстановяване се обновяват веднъж.
+ */
+void importPropertiesFromFile(PropertyStore& store);
+
+#endif
@@ -0,0 +1,285 @@
+/**
+ * @file index.h
+ * @brief Този файл декларира индексните структури, които PropertyStore поддържа върху имотите.
+ *
+ * Индексите позволяват бързо намиране на имоти без последователно обхождане на целия каталог
+ * и се актуализират автоматично от PropertyStore при всяко добавяне, изтриване,
+ * промяна, сортиране и зареждане.
+ */
+
+#ifndef INDEX_H
+#define INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Хеш индекс с отворено адресиране от референтен номер към позиция в PropertyStore.
+ *
+ * Използва линейно пробване и изтриване чрез обратно изместване (без маркери за изтрити записи),
+ * така че търсенето, добавянето и премахването имат средна сложност O(1).
+ * Таблицата се поддържа запълнена най-много наполовина.
+ */
+class RefNumberIndex {
+public:
+    /**
+     * @brief Премахва всички записи от индекса.
+     */
+    void clear();
+
+    /**
+     * @brief Оразмерява таблицата предварително за указания брой записи.
+     * @param count Очакваният брой референтни номера.
+     */
+    void reserve(int count);
+
+    /**
+     * @brief Добавя съответствие между референтен номер и позиция.
+     * @param refNumber Референтният номер.
+     * @param slot Позицията на имота в PropertyStore.
+     *
+     * Ако референтният номер вече присъства, запазва се първото съответствие.
+     */
+    void insert(int refNumber, int slot);
+
+    /**
+     * @brief Премахва референтен номер от индекса.
+     * @param refNumber Референтният номер за премахване.
+     */
+    void erase(int refNumber);
+
+    /**
+     * @brief Търси позицията на имот по неговия референтен номер.
+     * @param refNumber Търсеният референтен номер.
+     * @return Позицията на имота или -1, ако не е намерен.
+     */
+    int find(int refNumber) const;
+
+    /**
+     * @brief Намалява с единица всички позиции, по-големи от `slot`.
+     * @param slot Позицията, от която е премахнат имот.
+     *
+     * Извиква се след премахване на имот, когато следващите имоти се изместват с една позиция напред.
+     */
+    void shiftSlotsAfter(int slot);
+
+private:
+    struct Bucket {
+        int refNumber;
+        int slot;
+    };
+
+    size_t bucketFor(int refNumber) const;
+    void grow(size_t newCapacity);
+
+    std::vector<Bucket> buckets;
+    int used = 0;
+};
+
+/**
+ * @brief Списък от двойки (ключ, позиция), подреден възходящо по ключ, а при равен ключ - по позиция.
+ *
+ * Служи като подреден индекс по едно числово поле: позициите в даден интервал от стойности
+ * се намират с двоично търсене и едно обхождане, т.е. за O(log n + брой резултати).
+ *
+ * Списъкът се поддържа подреден при всяка промяна, затова методите за търсене само четат
+ * и могат да се извикват едновременно от няколко нишки. Единичните промени вмъкват записа
+ * на мястото му чрез двоично търсене. При масово зареждане записите се дописват чрез `append`
+ * и се подреждат наведнъж от `finishAppend`; между двете извиквания списъкът не бива да се търси.
+ */
+class SortedSlotList {
+public:
+    /**
+     * @brief Премахва всички записи.
+     */
+    void clear();
+
+    /**
+     * @brief Връща броя на записите.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Добавя позиция в края на списъка, без да го подрежда (при масово зареждане).
+     * @param key Стойността на полето за имота на позицията.
+     * @param slot Позицията на имота в PropertyStore.
+     */
+    void append(double key, int slot);
+
+    /**
+     * @brief Подрежда записите, добавени чрез `append` след последното подреждане.
+     *
+     * Новите записи се сортират отделно и се сливат с вече подредената част,
+     * така че допълването на голям списък не сортира отново целия списък.
+     */
+    void finishAppend();
+
+    /**
+     * @brief Вмъква позиция директно на мястото ѝ чрез двоично търсене (при единична промяна).
+     * @param key Стойността на полето за имота на позицията.
+     * @param slot Позицията на имота в PropertyStore.
+     */
+    void place(double key, int slot);
+
+    /**
+     * @brief Премахва позиция от списъка.
+     * @param key Стойността, с която е добавена позицията.
+     * @param slot Позицията на имота.
+     */
+    void erase(double key, int slot);
+
+    /**
+     * @brief Намалява с единица всички позиции, по-големи от `slot`.
+     * @param slot Позицията, от която е премахнат имот.
+     *
+     * Относителният ред на позициите не се променя, затова списъкът остава подреден.
+     */
+    void shiftSlotsAfter(int slot);
+
+    /**
+     * @brief Връща позициите, подредени по ключ.
+     * @param sortAscending true за възходящ ред, false за низходящ.
+     * @param limit Най-много колко позиции да бъдат върнати (първите в избрания ред).
+     * @return Позициите; при равен ключ по-малката позиция е първа и в двете посоки.
+     *
+     * Сложността е O(брой върнати позиции), затова първите `limit` най-малки или
+     * най-големи стойности се вземат от индекса без обхождане на целия списък.
+     */
+    std::vector<uint32_t> collect(bool sortAscending, size_t limit = SIZE_MAX) const;
+
+    /**
+     * @brief Връща позициите с ключ в затворения интервал `[low, high]`, във възходящ ред по ключ.
+     */
+    std::vector<uint32_t> collectRange(double low, double high) const;
+
+    /**
+     * @brief Връща броя на позициите с ключ в затворения интервал `[low, high]` без да ги извлича.
+     */
+    size_t countRange(double low, double high) const;
+
+    /**
+     * @brief Връща ключа на позиция `rank` в подредения списък (0 е най-малкият ключ).
+     * @param rank Рангът; трябва да е по-малък от `size()`.
+     */
+    double keyAt(size_t rank) const;
+
+    /**
+     * @brief Връща позицията с най-голям ключ, а при няколко такива - най-малката от тях, за O(log n).
+     * @return Позицията или -1 за празен списък.
+     */
+    int largestSlot() const;
+
+private:
+    struct Entry {
+        double key;
+        uint32_t slot;
+    };
+
+    static bool entryLess(const Entry& a, const Entry& b);
+    std::pair<size_t, size_t> findRange(double low, double high) const;
+
+    std::vector<Entry> entries;
+    size_t sortedCount = 0;
+};
+
+/**
+ * @brief Индекс от ключ (например идентификатор на брокер) към списък с позиции, подредени по цена.
+ *
+ * За всеки ключ се пази отделен `SortedSlotList` с цените на имотите. Търсенето връща
+ * позициите в търсения ред с едно обхождане на списъка (напред или назад), без сортиране,
+ * т.е. за време O(брой резултати). Както при `SortedSlotList`, след `append` трябва
+ * да се извика `finishAppend`, преди индексът да бъде търсен или променян.
+ */
+class PostingIndex {
+public:
+    /**
+     * @brief Премахва всички списъци.
+     */
+    void clear();
+
+    /**
+     * @brief Добавя позиция в списъка на даден ключ директно на мястото ѝ (при единична промяна).
+     * @param key Ключът.
+     * @param price Цената на имота на позицията.
+     * @param slot Позицията на имота в PropertyStore.
+     *
+     * Мястото се намира чрез двоично търсене, както при `move`, така че следващото търсене
+     * по ключа не сортира списъка.
+     */
+    void insert(uint32_t key, double price, int slot);
+
+    /**
+     * @brief Добавя позиция в края на списъка на даден ключ (при масово възстановяване на индекса).
+     * @param key Ключът.
+     * @param price Цената на имота на позицията.
+     * @param slot Позицията на имота в PropertyStore.
+     */
+    void append(uint32_t key, double price, int slot);
+
+    /**
+     * @brief Подрежда по цена списъците, допълнени чрез `append`.
+     */
+    void finishAppend();
+
+    /**
+     * @brief Премахва позиция от списъка на даден ключ.
+     * @param key Ключът, под който е добавена позицията.
+     * @param price Цената, с която е добавена позицията.
+     * @param slot Позицията на имота.
+     */
+    void erase(uint32_t key, double price, int slot);
+
+    /**
+     * @brief Премества позиция след промяна на ключа или цената на имота.
+     * @param oldKey Ключът преди промяната.
+     * @param oldPrice Цената преди промяната.
+     * @param newKey Ключът след промяната.
+     * @param newPrice Цената след промяната.
+     * @param slot Позицията на имота.
+     *
+     * Позицията се вмъква директно на мястото си чрез двоично търсене,
+     * така че единична промяна не води до пълно сортиране.
+     */
+    void move(uint32_t oldKey, double oldPrice, uint32_t newKey, double newPrice, int slot);
+
+    /**
+     * @brief Намалява с единица всички позиции, по-големи от `slot`.
+     * @param slot Позицията, от която е премахнат имот.
+     */
+    void shiftSlotsAfter(int slot);
+
+    /**
+     * @brief Връща позициите с даден ключ, подредени по цена.
+     * @param key Търсеният ключ.
+     * @param sortAscending true за възходящ ред по цена, false за низходящ.
+     * @param limit Най-много колко позиции да бъдат върнати (първите в избрания ред).
+     * @return Позициите; при равна цена по-малката позиция е първа и в двете посоки.
+     */
+    std::vector<uint32_t> collect(uint32_t key, bool sortAscending, size_t limit = SIZE_MAX) const;
+
+    /**
+     * @brief Връща броя на позициите с даден ключ.
+     */
+    size_t count(uint32_t key) const;
+
+    /**
+     * @brief Връща цената на позиция `rank` в подредения по цена списък на даден ключ.
+     * @param key Ключът.
+     * @param rank Рангът (0 е най-ниската цена); трябва да е по-малък от `count(key)`.
+     */
+    double keyAt(uint32_t key, size_t rank) const;
+
+    /**
+     * @brief Връща позицията с най-висока цена в списъка на даден ключ (виж `SortedSlotList::largestSlot`).
+     * @return Позицията или -1, ако ключът няма позиции.
+     */
+    int largestSlot(uint32_t key) const;
+
+private:
+    std::unordered_map<uint32_t, SortedSlotList> lists;
+};
+
+#endif
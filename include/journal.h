@@ -0,0 +1,83 @@
+/**
+ * @file journal.h
+ * @brief Този файл декларира журнала на промените (write-ahead log) към файловете за възстановяване.
+ *
+ * Вместо след всяка промяна файловете `sync.txt` и `sync.dat` да се презаписват изцяло,
+ * всяко добавяне, промяна или изтриване се дописва като един кратък ред в журнала.
+ * Периодично (и при сортиране, зареждане и изход) се прави контролна точка: пълният каталог
+ * се записва в `sync.dat`, а журналът се изчиства. При стартиране журналът се прилага
+ * върху последната контролна точка.
+ *
+ * Всяка промяна се записва в журнала и се синхронизира с диска, преди да бъде приложена
+ * в паметта, затова промяна, за която потребителят е получил потвърждение, оцелява и при
+ * срив на програмата или на системата. Ако журналът не може да бъде отворен, промяната
+ * се записва чрез пълна контролна точка след прилагането си.
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "structs.h"
+#include "store.h"
+
+/**
+ * @brief Минимален брой записи в журнала, след които автоматично се прави контролна точка.
+ *
+ * При по-голям каталог интервалът е равен на броя на имотите.
+ */
+const int JOURNAL_CHECKPOINT_INTERVAL = 1000;
+
+/**
+ * @brief Добавя имот в контейнера, като първо записва добавянето в журнала.
+ * @param store Контейнерът, в който се добавя имотът.
+ * @param property Новият имот.
+ * @return false, ако контейнерът отхвърля имота (`PropertyStore::isStorable`); тогава нищо не се записва.
+ */
+bool addPropertyWithJournal(PropertyStore& store, const Property& property);
+
+/**
+ * @brief Променя имот в контейнера, като първо записва промяната в журнала.
+ * @param store Контейнерът с имота.
+ * @param slot Позицията на имота в контейнера.
+ * @param property Новите данни на имота.
+ * @return false, ако контейнерът отхвърля новите данни (`PropertyStore::isStorable`); тогава нищо не се записва.
+ */
+bool updatePropertyWithJournal(PropertyStore& store, int slot, const Property& property);
+
+/**
+ * @brief Изтрива имот от контейнера, като първо записва изтриването в журнала.
+ * @param store Контейнерът с имота.
+ * @param slot Позицията на имота в контейнера.
+ */
+void removePropertyWithJournal(PropertyStore& store, int slot);
+
+/**
+ * @brief Изтрива всички имоти, като първо записва изчистването в журнала.
+ * @param store Контейнерът, който се изчиства.
+ */
+void clearPropertiesWithJournal(PropertyStore& store);
+
+/**
+ * @brief Изчиства журнала и го отваря наново за дописване.
+ * @param path Пътят до файла на журнала.
+ *
+ * Извиква се веднага след като пълният каталог е записан в `sync.dat`.
+ */
+void resetJournal(const char* path);
+
+/**
+ * @brief Затваря файла на журнала.
+ */
+void closeJournal();
+
+/**
+ * @brief Прилага записите от журнала върху контейнер, зареден от последната контролна точка.
+ * @param path Пътят до файла на журнала.
+ * @param store Контейнерът, върху който се прилагат промените.
+ * @return Броят на приложените записи.
+ *
+ * Прилагането спира на първия непълен или повреден ред (например при срив по време на запис).
+ */
+int replayJournal(const char* path, PropertyStore& store);
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * @file kernels.h
+ * @brief Този файл декларира векторизираните изчислителни ядра върху колоните на PropertyStore.
+ *
+ * Ядрата обработват цели колони с SIMD инструкции: на x86 процесори с AVX2 по 4 стойности
+ * наведнъж (изборът става при изпълнение), иначе с SSE2 по 2 стойности. На други архитектури
+ * се използва скаларният вариант, който е достъпен и отделно за сравнение и проверка.
+ * Векторизираните и скаларните варианти дават побитово еднакви резултати.
+ */
+
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <cstdint>
+
+/**
+ * @brief Изчислява цената на квадратен метър за `count` имота.
+ * @param prices Колоната с цени.
+ * @param totalAreas Колоната с общи площи.
+ * @param count Броят на имотите.
+ * @param out Изходна колона с `count` елемента; за имот без положителна площ стойността е NaN.
+ */
+void computePricePerSquareMetre(const double* prices, const double* totalAreas, int count, double* out);
+
+/**
+ * @brief Скаларен вариант на `computePricePerSquareMetre`.
+ */
+void computePricePerSquareMetreScalar(const double* prices, const double* totalAreas, int count, double* out);
+
+/**
+ * @brief Отбелязва стойностите, които се отклоняват от средното на групата си повече от допустимото.
+ * @param values Колоната със стойности; NaN никога не се отбелязва.
+ * @param keys Колоната с ключа на групата на всеки ред (например идентификатор на район).
+ * @param means Средното на всяка група, индексирано с ключа.
+ * @param limits Допустимото отклонение на всяка група, индексирано с ключа.
+ * @param count Броят на редовете.
+ * @param flags Изходна колона: 1, ако `|values[i] - means[keys[i]]| > limits[keys[i]]`, иначе 0.
+ * @return Броят на отбелязаните редове.
+ */
+int flagDeviations(const double* values, const uint32_t* keys, const double* means, const double* limits, int count,
+                   unsigned char* flags);
+
+/**
+ * @brief Скаларен вариант на `flagDeviations`.
+ */
+int flagDeviationsScalar(const double* values, const uint32_t* keys, const double* means, const double* limits,
+                         int count, unsigned char* flags);
+
+/**
+ * @brief Връща името на набора от инструкции, който ядрата използват на текущия процесор
+ * (`avx2`, `sse2` или `scalar`).
+ */
+const char* simdKernelName();
+
+#endif
@@ -0,0 +1,56 @@
+/**
+ * @file mapping.h
+ * @brief Този файл декларира обвивка за проектиране на файл в паметта само за четене (`mmap`).
+ *
+ * Проектираният файл се чете директно от кеша на страниците на операционната система,
+ * без междинно копиране в буфер на приложението.
+ */
+
+#ifndef MAPPING_H
+#define MAPPING_H
+
+#include <cstddef>
+
+/**
+ * @brief Файл, проектиран в паметта само за четене.
+ *
+ * Проекцията се освобождава от деструктора или от `close`. Обектът не може да бъде копиран.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Отваря файл и го проектира в паметта.
+     * @param path Пътят до файла.
+     * @return true, ако файлът е отворен; false, ако не съществува или не може да бъде проектиран.
+     *
+     * Празен файл се отваря успешно с `size() == 0` и `data() == nullptr`.
+     */
+    bool open(const char* path);
+
+    /**
+     * @brief Освобождава проекцията и затваря файла.
+     */
+    void close();
+
+    /**
+     * @brief Връща указател към началото на съдържанието на файла.
+     */
+    const char* data() const;
+
+    /**
+     * @brief Връща размера на файла в байтове.
+     */
+    size_t size() const;
+
+private:
+    const char* mappedData = nullptr;
+    size_t mappedSize = 0;
+};
+
+#endif
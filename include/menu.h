@@ -11,79 +11,72 @@
 #define MENU_H
 
 #include "structs.h" 
+#include "store.h"
 
 /**
  * @brief Показва главното меню на приложението и обработва изборите на потребителя.
- * @param properties Масив от структури Property, представляващ основния набор от данни.
- * @param propertyCount Референция към цяло число, съдържащо текущия брой имоти.
+ * @param store Контейнерът с имоти, представляващ основния набор от данни.
  *
  * Тази функция служи като централен навигационен център, насочвайки потребителите към различни
  * части на приложението въз основа на техния вход.
  */
-void mainMenu(Property properties[], int& propertyCount);
+void mainMenu(PropertyStore& store);
 
 /**
  * @brief Показва менюто за добавяне на имоти и обработва изборите на потребителя.
- * @param properties Масив от структури Property, където ще бъдат добавени новите имоти.
- * @param propertyCount Референция към цяло число, съдържащо текущия брой имоти.
+ * @param store Контейнерът с имоти, в който ще бъдат добавени новите имоти.
  *
  * Позволява на потребителите да избират между добавяне на един имот или множество имоти.
  */
-void addPropertyMenu(Property properties[], int& propertyCount);
+void addPropertyMenu(PropertyStore& store);
 
 /**
  * @brief Показва менюто за преглед на имоти и обработва изборите на потребителя.
- * @param properties Постоянен масив от структури Property за показване.
- * @param propertyCount Текущият брой имоти в системата.
+ * @param store Контейнерът с имоти за показване.
  *
  * Предоставя опции за показване на всички имоти, продадени имоти или имоти, сортирани по размер.
  */
-void displayMenu(const Property properties[], int propertyCount);
+void displayMenu(const PropertyStore& store);
 
 /**
  * @brief Показва менюто за изтриване на имоти и обработва изборите на потребителя.
- * @param properties Масив от структури Property, от които ще бъдат изтрити имоти.
- * @param propertyCount Референция към цяло число, съдържащо текущия брой имоти.
+ * @param store Контейнерът с имоти, от който ще бъдат изтрити имоти.
  *
  * Позволява на потребителите да изтриват един имот по референтен номер или да изчистват всички имоти.
  */
-void deletePropertyMenu(Property properties[], int& propertyCount);
+void deletePropertyMenu(PropertyStore& store);
 
 /**
  * @brief Показва менюто за търсене на имоти и обработва изборите на потребителя.
- * @param properties Постоянен масив от структури Property за търсене.
- * @param propertyCount Текущият брой имоти в системата.
+ * @param store Контейнерът с имоти за търсене.
  *
  * Предлага опции за търсене на имоти по име на брокер или по брой стаи.
  */
-void searchMenu(Property properties[], int propertyCount);
+void searchMenu(const PropertyStore& store);
 
 /**
  * @brief Показва менюто за сортиране на имоти и обработва изборите на потребителя.
- * @param properties Масив от структури Property за сортиране.
- * @param propertyCount Текущият брой имоти в системата.
+ * @param store Контейнерът с имоти за сортиране.
  *
  * Предоставя различни критерии за сортиране на имоти, като цена, площ или референтен номер.
  */
-void sortMenu(Property properties[], int propertyCount);
+void sortMenu(PropertyStore& store);
 
 /**
  * @brief Показва менюто за файлови операции (запис/зареждане) и обработва изборите на потребителя.
- * @param properties Масив от структури Property за файлови операции.
- * @param propertyCount Референция към цяло число, съдържащо текущия брой имоти.
+ * @param store Контейнерът с имоти за файлови операции.
  *
  * Позволява на потребителите да записват данни в различни файлови формати (двоичен, текстов) и да зареждат данни.
  */
-void fileMenu(Property properties[], int& propertyCount);
+void fileMenu(PropertyStore& store);
 
 /**
  * @brief Показва менюто за генериране на отчети и обработва изборите на потребителя.
- * @param properties Постоянен масив от структури Property за генериране на отчети.
- * @param propertyCount Текущият брой имоти в системата.
+ * @param store Контейнерът с имоти за генериране на отчети.
  *
  * Предлага опции за генериране на аналитични отчети, като най-скъп в района,
  * средна цена или процент на продадени от брокер.
  */
-void reportsMenu(const Property properties[], int propertyCount);
+void reportsMenu(const PropertyStore& store);
 
 #endif 
@@ -0,0 +1,58 @@
+/**
+ * @file parse.h
+ * @brief Този файл декларира разчитането на текстовия формат за синхронизация (`sync.txt`).
+ *
+ * Всеки ред съдържа 10 полета, разделени с | (pipe): референтен номер, брокер, тип, район,
+ * изложение, цена, обща площ, стаи, етаж и статус. Числата се разчитат чрез `std::from_chars`,
+ * без зависимост от локала и без междинни низове.
+ */
+
+#ifndef PARSE_H
+#define PARSE_H
+
+#include <cstddef>
+
+#include "structs.h"
+#include "store.h"
+
+/**
+ * @brief Размер на текста (в байтове), над който `parseSyncText` разделя работата между няколко нишки.
+ */
+const size_t PARALLEL_PARSE_THRESHOLD = 4 * 1024 * 1024;
+
+/**
+ * @brief Разчита един ред във формата на `sync.txt`.
+ * @param begin Началото на реда.
+ * @param end Краят на реда (без символа за нов ред).
+ * @param property Структурата, в която се записва резултатът.
+ * @return true, ако редът съдържа всички 10 полета, в противен случай false.
+ *
+ * Текстовите полета се съкращават до размера на буферите в `Property`,
+ * а невалиден статус се заменя с `AVAILABLE`. Ред, чиято цена или обща площ
+ * не е крайно число (`nan`, `inf`), се смята за повреден.
+ */
+bool parseSyncRecord(const char* begin, const char* end, Property& property);
+
+/**
+ * @brief Разчита полетата на един ред във формата на `sync.txt`, без да проверява стойностите на числата.
+ * @return true, ако редът съдържа всички 10 полета, в противен случай false.
+ *
+ * Използва се от пакетния режим, който отличава синтактична грешка от недопустима стойност.
+ */
+bool parseSyncFields(const char* begin, const char* end, Property& property);
+
+/**
+ * @brief Разчита съдържанието на файл във формата на `sync.txt` и добавя имотите в контейнера.
+ * @param data Началото на текста.
+ * @param size Размерът на текста в байтове.
+ * @param store Контейнерът, в който се добавят имотите.
+ * @param threadCount Брой нишки; 0 избира автоматично според размера на текста и броя на ядрата.
+ * @return Броят на добавените имоти.
+ *
+ * Разчитането спира на първия невалиден ред, както и при последователното четене.
+ * С повече от една нишка текстът се разделя на части по границите на редовете,
+ * частите се разчитат едновременно и резултатите се добавят в контейнера в реда на файла.
+ */
+int parseSyncText(const char* data, size_t size, PropertyStore& store, int threadCount = 0);
+
+#endif
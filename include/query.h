@@ -0,0 +1,196 @@
+/**
+ * @file query.h
+ * @brief Този файл декларира машината за съставни заявки върху PropertyStore.
+ *
+ * Заявката е дърво от условия (брокер, район, тип, изложение, статус, стаи, етаж,
+ * цена, обща площ), съчетани с И/ИЛИ. Тя се изпълнява с едно обхождане на колоните
+ * на блокове от редове: всяко условие попълва битова маска за блока чрез прост цикъл
+ * без разклонения, който компилаторът може да векторизира, а маските се съчетават
+ * с побитови операции. Резултатът е `Selection` - битова маска над позициите в контейнера.
+ */
+
+#ifndef QUERY_H
+#define QUERY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "structs.h"
+#include "store.h"
+
+/**
+ * @brief Множество от позиции в PropertyStore, представено като битова маска (по един бит за позиция).
+ */
+class Selection {
+public:
+    /**
+     * @brief Създава празно множество за контейнер с `size` позиции.
+     */
+    explicit Selection(int size = 0);
+
+    /**
+     * @brief Връща броя на позициите в контейнера, за който е създадено множеството.
+     */
+    int size() const;
+
+    /**
+     * @brief Връща броя на избраните позиции.
+     */
+    int count() const;
+
+    /**
+     * @brief Проверява дали позицията `slot` е избрана.
+     */
+    bool test(int slot) const;
+
+    /**
+     * @brief Връща избраните позиции във възходящ ред.
+     */
+    std::vector<uint32_t> slots() const;
+
+    /**
+     * @brief Извиква `visit(slot)` за всяка избрана позиция във възходящ ред.
+     *
+     * Празните 64-битови думи се пропускат изцяло, а в непразните се обхождат само вдигнатите битове.
+     */
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        for (size_t word = 0; word < words.size(); word++) {
+            uint64_t bits = words[word];
+            while (bits != 0) {
+                visit((uint32_t)(word * 64 + __builtin_ctzll(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+private:
+    friend class Query;
+
+    std::vector<uint64_t> words;
+    int rows;
+};
+
+/**
+ * @brief Съставна заявка върху имотите в PropertyStore.
+ *
+ * Заявките се създават чрез статичните функции и се съчетават с `&&` и `||`, например
+ * `Query::broker("Иван") && (Query::rooms(3, 3) || Query::price(0, 100000))`.
+ * Текстовите условия се превеждат в идентификатори чрез речниците на контейнера веднъж,
+ * при изпълнение; стойност, която липсва в речника, не съвпада с нито един имот.
+ */
+class Query {
+public:
+    /**
+     * @brief Заявка, на която отговарят всички имоти.
+     */
+    static Query all();
+
+    /**
+     * @brief Условия за точно съвпадение на текстово поле.
+     */
+    static Query broker(const std::string& name);
+    static Query area(const std::string& name);
+    static Query type(const std::string& name);
+    static Query exposition(const std::string& name);
+
+    /**
+     * @brief Условие за точно съвпадение на статуса.
+     */
+    static Query status(Status status);
+
+    /**
+     * @brief Условия за числово поле в затворения интервал `[low, high]`.
+     */
+    static Query rooms(double low, double high);
+    static Query floor(double low, double high);
+    static Query price(double low, double high);
+    static Query totalArea(double low, double high);
+
+    /**
+     * @brief Съчетава две заявки с И.
+     */
+    Query operator&&(const Query& other) const;
+
+    /**
+     * @brief Съчетава две заявки с ИЛИ.
+     */
+    Query operator||(const Query& other) const;
+
+    /**
+     * @brief Изпълнява заявката върху контейнера.
+     * @param store Контейнерът с имоти.
+     * @return Битовата маска на позициите, които отговарят на заявката.
+     *
+     * Колоните се обхождат веднъж, на блокове от `QUERY_BLOCK_ROWS` реда. При И обработката
+     * на блока спира, щом маската стане празна, а при ИЛИ - щом стане пълна.
+     */
+    Selection evaluate(const PropertyStore& store) const;
+
+    /**
+     * @brief Изпълнява заявката и връща позициите на съвпадащите имоти във възходящ ред.
+     */
+    std::vector<uint32_t> findSlots(const PropertyStore& store) const;
+
+    /**
+     * @brief Изпълнява заявката и връща позициите на съвпадащите имоти, подредени по цена.
+     * @param store Контейнерът с имоти.
+     * @param sortAscending true за възходящ ред по цена, false за низходящ.
+     * @return Позициите; имотите с еднаква цена са в реда си в каталога.
+     *
+     * Ако заявката (или някое от условията ѝ, съчетани с И) може да се отговори от индекс
+     * на контейнера - брокер, брой стаи, цена, обща площ или етаж - се избира условието
+     * с най-малко съвпадения, кандидатите се вземат от неговия индекс и само за тях се
+     * проверява цялата заявка. Иначе колоните се обхождат чрез `evaluate`.
+     */
+    std::vector<uint32_t> findSlotsByPrice(const PropertyStore& store, bool sortAscending) const;
+
+private:
+    enum Field {
+        FIELD_BROKER,
+        FIELD_TYPE,
+        FIELD_AREA,
+        FIELD_EXPOSITION,
+        FIELD_STATUS,
+        FIELD_ROOMS,
+        FIELD_FLOOR,
+        FIELD_PRICE,
+        FIELD_TOTAL_AREA
+    };
+
+    enum Kind {
+        KIND_ALL,
+        KIND_AND,
+        KIND_OR,
+        KIND_TEXT,
+        KIND_RANGE
+    };
+
+    struct CompiledNode;
+
+    Query(Kind kind, Field field);
+    static Query text(Field field, const std::string& value);
+    static Query range(Field field, double low, double high);
+    int compile(const PropertyStore& store, std::vector<CompiledNode>& nodes) const;
+    static void evaluateBlock(const std::vector<CompiledNode>& nodes, int index, int begin, int count, uint64_t* mask);
+    static bool matchesSlot(const std::vector<CompiledNode>& nodes, int index, uint32_t slot);
+    size_t indexedCount(const PropertyStore& store) const;
+    std::vector<uint32_t> indexedSlots(const PropertyStore& store, bool sortAscending, bool& ordered) const;
+
+    Kind kind;
+    Field field;
+    std::string value;
+    double low;
+    double high;
+    std::vector<Query> children;
+};
+
+/**
+ * @brief Брой редове, които се обработват наведнъж при изпълнение на заявка.
+ *
+ * Маските на един блок (16 думи по 64 бита) се побират в регистрите и кеша L1.
+ */
+const int QUERY_BLOCK_ROWS = 1024;
+
+#endif
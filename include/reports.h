@@ -10,33 +10,240 @@
 #ifndef REPORTS_H
 #define REPORTS_H
 
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
 #include "structs.h" 
+#include "store.h"
+
+/**
+ * @brief Брой на всички и на продадените имоти на един брокер.
+ */
+struct BrokerSales {
+    uint32_t brokerId;
+    int total;
+    int sold;
+};
+
+/**
+ * @brief Имот с необичайна цена на кв.м. за района си.
+ *
+ * `deviation` е отклонението на цената на кв.м. от средната за района, измерено
+ * в стандартни отклонения (положително за по-скъпи имоти).
+ */
+struct PriceOutlier {
+    uint32_t slot;
+    double pricePerSqm;
+    double deviation;
+};
+
+/**
+ * @brief Брой, сума на цените и най-скъп имот за един район в отчета за всички райони.
+ */
+struct AreaSummary {
+    uint32_t areaId;
+    int count;
+    double totalPrice;
+    int mostExpensiveSlot;
+};
+
+/**
+ * @brief Ред на районите в отчета за всички райони.
+ *
+ * Освен по име, районите се подреждат низходящо; при равенство - по име.
+ */
+enum AreaSortOrder {
+    AREA_SORT_BY_NAME,
+    AREA_SORT_BY_COUNT,
+    AREA_SORT_BY_AVERAGE,
+    AREA_SORT_BY_MAX_PRICE,
+    AREA_SORT_ORDER_COUNT
+};
 
 /**
  * @brief Намира и показва най-скъпия имот в указан от потребителя район.
- * @param properties Масив от структури Property за анализ.
- * @param propertyCount Броят на имотите в масива.
+ * @param store Контейнерът с имоти за анализ.
  *
  * Този отчет помага за идентифициране на премиум обяви в конкретни географски местоположения.
  */
-void mostExpensiveInArea(const Property properties[], int propertyCount);
+void mostExpensiveInArea(const PropertyStore& store);
 
 /**
  * @brief Изчислява и показва средната цена на имотите в указан от потребителя район.
- * @param properties Масив от структури Property за анализ.
- * @param propertyCount Броят на имотите в масива.
+ * @param store Контейнерът с имоти за анализ.
  *
  * Предоставя пазарна информация чрез осредняване на цените, полезна за ценови стратегии и информация за купувачи.
  */
-void averagePriceInArea(const Property properties[], int propertyCount);
+void averagePriceInArea(const PropertyStore& store);
 
 /**
  * @brief Изчислява и показва процента на продадените имоти от всеки брокер.
- * @param properties Масив от структури Property за анализ.
- * @param propertyCount Броят на имотите в масива.
+ * @param store Контейнерът с имоти за анализ.
  *
  * Този отчет предлага показатели за ефективността на отделните брокери, подчертавайки ефективността на продажбите.
  */
-void soldPercentagePerBroker(const Property properties[], int propertyCount);
+void soldPercentagePerBroker(const PropertyStore& store);
+
+/**
+ * @brief Показва K-те най-скъпи имота в указан от потребителя район.
+ * @param store Контейнерът с имоти за анализ.
+ */
+void topExpensiveInArea(const PropertyStore& store);
+
+/**
+ * @brief Показва K-те имота с най-голяма обща площ.
+ * @param store Контейнерът с имоти за анализ.
+ */
+void topLargestProperties(const PropertyStore& store);
+
+/**
+ * @brief Показва K-те имота с най-ниска цена на квадратен метър.
+ * @param store Контейнерът с имоти за анализ.
+ */
+void topCheapestPerSquareMetre(const PropertyStore& store);
+
+/**
+ * @brief Показва справка по избор: групиране по избрани полета и избрани показатели.
+ * @param store Контейнерът с имоти за анализ.
+ *
+ * Потребителят избира полетата за групиране и показателите един по един, след което
+ * справката се изчислява чрез `buildGroupReport` и се показва като таблица.
+ */
+void customGroupReport(const PropertyStore& store);
+
+/**
+ * @brief Показва медианата, 90-ия и 99-ия персентил на цените по район или по тип имот.
+ * @param store Контейнерът с имоти за анализ.
+ *
+ * За разлика от средната цена персентилите не се изместват от отделни много скъпи имоти.
+ */
+void pricePercentiles(const PropertyStore& store);
+
+/**
+ * @brief Показва статистика на цената на кв.м. по район, по тип или по брой стаи.
+ * @param store Контейнерът с имоти за анализ.
+ */
+void pricePerSquareMetreReport(const PropertyStore& store);
+
+/**
+ * @brief Показва имотите с необичайна цена на кв.м. за района си.
+ * @param store Контейнерът с имоти за анализ.
+ *
+ * Потребителят задава броя стандартни отклонения N; показват се имотите, чиято цена на кв.м.
+ * е на повече от N стандартни отклонения от средната за района им.
+ */
+void pricePerSquareMetreOutliers(const PropertyStore& store);
+
+/**
+ * @brief Показва или записва във файл броя, средната и най-високата цена за всички райони.
+ * @param store Контейнерът с имоти за анализ.
+ *
+ * Потребителят избира реда на районите и път до файл (празен път показва таблицата на екрана).
+ */
+void allAreasReport(const PropertyStore& store);
+
+/**
+ * @brief Намира позицията на най-скъпия имот в даден район.
+ * @param store Контейнерът с имоти за анализ.
+ * @param area Името на района.
+ * @return Позицията на имота или -1, ако в района няма имоти.
+ */
+int findMostExpensiveInArea(const PropertyStore& store, const char* area);
+
+/**
+ * @brief Намира позициите на K-те най-скъпи имота в даден район.
+ * @param store Контейнерът с имоти за анализ.
+ * @param area Името на района.
+ * @param count Броят K.
+ * @return Позициите по цена в низходящ ред; при еднаква цена - в реда им в каталога.
+ *
+ * Имотите в района се обхождат веднъж, като се пазят само K-те най-добри (O(n log K)).
+ */
+std::vector<uint32_t> findTopExpensiveInArea(const PropertyStore& store, const char* area, size_t count);
+
+/**
+ * @brief Намира позициите на K-те имота с най-голяма обща площ.
+ * @param store Контейнерът с имоти за анализ.
+ * @param count Броят K.
+ * @return Позициите по обща площ в низходящ ред; при еднаква площ - в реда им в каталога.
+ *
+ * Позициите се вземат от края на подредения индекс по обща площ за O(K).
+ */
+std::vector<uint32_t> findLargestProperties(const PropertyStore& store, size_t count);
+
+/**
+ * @brief Намира позициите на K-те имота с най-ниска цена на квадратен метър.
+ * @param store Контейнерът с имоти за анализ.
+ * @param count Броят K.
+ * @return Позициите по цена на кв.м. във възходящ ред; имотите без положителна площ се пропускат.
+ *
+ * Колоните с цени и площи се обхождат веднъж, като се пазят само K-те най-добри (O(n log K)).
+ */
+std::vector<uint32_t> findCheapestPerSquareMetre(const PropertyStore& store, size_t count);
+
+/**
+ * @brief Сумира цените на имотите в даден район.
+ * @param store Контейнерът с имоти за анализ.
+ * @param area Името на района.
+ * @param totalPrice Изходен параметър за сумата на цените.
+ * @return Броят на имотите в района.
+ */
+int sumPricesInArea(const PropertyStore& store, const char* area, double& totalPrice);
+
+/**
+ * @brief Намира имотите, чиято цена на кв.м. се отклонява от средната за района им с повече от `sigmas` стандартни отклонения.
+ * @param store Контейнерът с имоти за анализ.
+ * @param sigmas Допустимият брой стандартни отклонения.
+ * @return Отклоненията, подредени по абсолютна стойност в низходящ ред; имотите без положителна площ се пропускат.
+ */
+std::vector<PriceOutlier> findPricePerSquareMetreOutliers(const PropertyStore& store, double sigmas);
+
+/**
+ * @brief Изчислява броя, сумата на цените и най-скъпия имот за всички райони с едно обхождане.
+ * @param store Контейнерът с имоти за анализ.
+ * @param threadCount Брой нишки; 0 избира автоматично (паралелно над `PARALLEL_GROUP_THRESHOLD` имота).
+ * @return Районите с поне един имот, подредени по име; при еднаква най-висока цена най-скъп е
+ * имотът с най-малка позиция, независимо от броя на нишките.
+ */
+std::vector<AreaSummary> computeAreaSummaries(const PropertyStore& store, int threadCount = 0);
+
+/**
+ * @brief Подрежда районите в отчета за всички райони.
+ * @param store Контейнерът, за който са изчислени районите.
+ * @param summaries Районите за подреждане.
+ * @param order Редът.
+ */
+void sortAreaSummaries(const PropertyStore& store, std::vector<AreaSummary>& summaries, AreaSortOrder order);
+
+/**
+ * @brief Записва отчета за всички райони като таблица.
+ * @param file Отворен за запис файл или `stdout`.
+ * @param store Контейнерът, за който са изчислени районите.
+ * @param summaries Районите в реда, в който да бъдат записани.
+ */
+void writeAreaSummaryTable(FILE* file, const PropertyStore& store, const std::vector<AreaSummary>& summaries);
+
+/**
+ * @brief Разчита име на ред за отчета за всички райони (`name`, `count`, `average`, `max`).
+ * @return true, ако името е познато.
+ */
+bool parseAreaSortOrder(const char* name, AreaSortOrder& order);
+
+/**
+ * @brief Връща точната медиана на цените в даден район чрез индекса по район.
+ * @param store Контейнерът с имоти за анализ.
+ * @param area Името на района.
+ * @return Медианата (цената с ранг `ceil(брой / 2)`) или 0, ако в района няма имоти.
+ */
+double medianPriceInArea(const PropertyStore& store, const char* area);
+
+/**
+ * @brief Събира броя на всички и на продадените имоти за всеки брокер.
+ * @param store Контейнерът с имоти за анализ.
+ * @param threadCount Брой нишки; 0 избира автоматично (паралелно над `PARALLEL_GROUP_THRESHOLD` имота).
+ * @return Статистиката по брокери с поне един имот, подредена по име на брокера.
+ */
+std::vector<BrokerSales> computeSalesPerBroker(const PropertyStore& store, int threadCount = 0);
 
 #endif 
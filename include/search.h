@@ -9,26 +9,77 @@
 #ifndef SEARCH_H
 #define SEARCH_H
 
+#include <cstdint>
+#include <vector>
+
 #include "structs.h" 
+#include "store.h"
 
 /**
  * @brief Търси и показва имоти, обработени от конкретен брокер.
- * @param properties Масив от структури Property, в който да се търси.
- * @param propertyCount Броят на имотите в масива.
+ * @param store Контейнерът с имоти, в който да се търси.
  *
  * Подканва потребителя за име на брокер и след това итерира през имотите,
  * показвайки тези, които съвпадат.
  */
-void searchByBroker(Property properties[], int propertyCount);
+void searchByBroker(const PropertyStore& store);
 
 /**
  * @brief Търси и показва имоти въз основа на броя стаи.
- * @param properties Масив от структури Property, в който да се търси.
- * @param propertyCount Броят на имотите в масива.
+ * @param store Контейнерът с имоти, в който да се търси.
  *
  * Подканва потребителя за брой стаи и след това итерира през имотите,
  * показвайки тези, които съвпадат или надвишават указания брой.
  */
-void searchByRooms(Property properties[], int propertyCount);
+void searchByRooms(const PropertyStore& store);
+
+/**
+ * @brief Търси и показва имоти по интервали от стойности на цена, обща площ, етаж и брой стаи.
+ * @param store Контейнерът с имоти, в който да се търси.
+ *
+ * За всяко поле потребителят избира дали да го използва като филтър и въвежда
+ * минимална и максимална стойност. Показват се имотите, които отговарят на всички
+ * избрани интервали, подредени по цена във възходящ ред.
+ */
+void searchByRanges(const PropertyStore& store);
+
+/**
+ * @brief Условие за търсене: стойността на полето `field` трябва да е в затворения интервал `[low, high]`.
+ */
+struct RangeCondition {
+    RangeField field;
+    double low;
+    double high;
+};
+
+/**
+ * @brief Намира позициите на имотите, които отговарят на всички условия, подредени по цена във възходящ ред.
+ * @param store Контейнерът с имоти, в който да се търси.
+ * @param conditions Условията; без условия се връщат всички имоти.
+ * @return Позициите на съвпадащите имоти; при еднаква цена - в реда им в каталога.
+ *
+ * Условията се изпълняват като заявка чрез `Query::findSlotsByPrice`: чрез подредените индекси
+ * на контейнера се избира условието с най-малко съвпадения, неговите позиции се извличат
+ * за O(log n + брой), а останалите условия се проверяват по колоните.
+ */
+std::vector<uint32_t> findSlotsInRanges(const PropertyStore& store, const std::vector<RangeCondition>& conditions);
+
+/**
+ * @brief Намира позициите на имотите на даден брокер, подредени по цена.
+ * @param store Контейнерът с имоти, в който да се търси.
+ * @param broker Името на брокера.
+ * @param sortAscending true за възходящ ред по цена, false за низходящ.
+ * @return Позициите на съвпадащите имоти; при еднаква цена - в реда им в каталога.
+ */
+std::vector<uint32_t> findSlotsByBroker(const PropertyStore& store, const char* broker, bool sortAscending);
+
+/**
+ * @brief Намира позициите на имотите с даден брой стаи, подредени по цена.
+ * @param store Контейнерът с имоти, в който да се търси.
+ * @param roomsCount Търсеният брой стаи.
+ * @param sortAscending true за възходящ ред по цена, false за низходящ.
+ * @return Позициите на съвпадащите имоти; при еднаква цена - в реда им в каталога.
+ */
+std::vector<uint32_t> findSlotsByRooms(const PropertyStore& store, int roomsCount, bool sortAscending);
 
 #endif 
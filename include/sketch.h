@@ -0,0 +1,91 @@
+/**
+ * @file sketch.h
+ * @brief Този файл декларира скица за приблизителни квантили (медиана, персентили) над поток от стойности.
+ *
+ * Скицата следва алгоритъма KLL: стойностите се пазят в нива от „компактори“, като всяка
+ * стойност на ниво h представя 2^h стойности от потока. Когато нивото се напълни, то се
+ * сортира и всяка втора стойност се премества на следващото ниво. Паметта е O(k) независимо
+ * от броя на стойностите, а грешката по ранг е около 1.7% при k = 200. Две скици се сливат
+ * ниво по ниво, затова всяка нишка може да натрупва собствена скица за своя дял от редовете.
+ */
+
+#ifndef SKETCH_H
+#define SKETCH_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Размер на най-горното ниво на скицата по подразбиране.
+ */
+const int QUANTILE_SKETCH_K = 200;
+
+/**
+ * @brief Връща ранга (от 1) на квантила `fraction` сред `count` подредени стойности.
+ * @return `ceil(fraction * count)`, ограничен в `[1, count]`; малкият допуск пази
+ * например 0.9 * 10 от закръгляне нагоре до 10.
+ */
+inline uint64_t quantileRank(double fraction, uint64_t count) {
+    double rank = std::ceil(fraction * (double)count - 1e-9);
+    if (rank < 1.0) {
+        return 1;
+    }
+    return rank > (double)count ? count : (uint64_t)rank;
+}
+
+/**
+ * @brief Сливаема скица за приблизителни квантили (KLL).
+ *
+ * Докато са добавени по-малко от k стойности, квантилите са точни. Минимумът и максимумът
+ * се пазят точно. Изборът коя половина от нивото да бъде преместена се редува детерминирано,
+ * така че една и съща последователност от стойности дава един и същ резултат.
+ * Скицата не поддържа премахване на стойности.
+ */
+class QuantileSketch {
+public:
+    /**
+     * @brief Създава празна скица.
+     * @param k Размерът на най-горното ниво; по-голямо k дава по-малка грешка срещу повече памет.
+     */
+    explicit QuantileSketch(int k = QUANTILE_SKETCH_K);
+
+    /**
+     * @brief Добавя стойност към скицата.
+     */
+    void add(double value);
+
+    /**
+     * @brief Слива друга скица в текущата (например частичната скица на друга нишка).
+     */
+    QuantileSketch& operator+=(const QuantileSketch& other);
+
+    /**
+     * @brief Връща броя на добавените стойности.
+     */
+    uint64_t count() const;
+
+    /**
+     * @brief Връща приблизителния квантил на добавените стойности.
+     * @param fraction Делът в `[0, 1]`, например 0.5 за медианата.
+     * @return Стойността с ранг `quantileRank(fraction, count())`; 0 за празна скица.
+     */
+    double quantile(double fraction) const;
+
+private:
+    size_t levelCapacity(size_t level) const;
+    void addLevel();
+    void compress();
+
+    int k;
+    uint64_t total;
+    size_t retained;
+    size_t maxRetained;
+    bool promoteOdd;
+    double minimum;
+    double maximum;
+    std::vector<std::vector<double>> levels;
+};
+
+#endif
@@ -1,61 +1,558 @@
 /**
  * @file sort.h
- * @brief Този файл декларира функции за сортиране на масиви от имоти.
+ * @brief Този файл декларира машината за сортиране на имоти.
  *
- * Той предоставя реализация на алгоритъма QuickSort, адаптиран за структури `Property`,
- * позволявайки имотите да бъдат сортирани въз основа на различни критерии (напр. цена, площ)
- * във възходящ или низходящ ред.
+ * Той предоставя introsort (бързо сортиране с опора „медиана от три“, сортиране чрез вмъкване
+ * за малки интервали и преминаване към пирамидално сортиране при твърде дълбока рекурсия)
+ * и стабилно сортиране чрез сливане. Сортирането по няколко полета (`sortSlotsByFields`)
+ * кодира посоката на всеки критерий в извлечените ключове, а компараторът `EncodedKeysLess`
+ * е специализиран по време на компилация за броя на критериите, така че при сравнение
+ * посоката не се проверява.
+ *
+ * Имотите в `PropertyStore` се сортират чрез пермутация: сортира се масив от 32-битови
+ * позиции заедно с извлечените ключове, а не самите записи.
  */
 
 #ifndef SORT_H
 #define SORT_H
 
-#include "structs.h" 
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "structs.h"
+#include "store.h"
 
 /**
- * @brief Сортира масив от структури Property, използвайки алгоритъма QuickSort.
- * @param arr Масивът от структури Property, който ще бъде сортиран.
- * @param size Броят на елементите в масива.
- * @param sortAscending Булев флаг: true за възходящ ред, false за низходящ.
+ * @brief Под този размер интервалите се сортират чрез вмъкване.
+ */
+const int INSERTION_SORT_THRESHOLD = 16;
+
+/**
+ * @brief Брой елементи, над който `sortSlotsByKey` разделя сортирането между няколко нишки.
+ */
+const size_t PARALLEL_SORT_THRESHOLD = 128 * 1024;
+
+/**
+ * @brief Избира броя на нишките за сортиране на `size` елемента.
+ * @param threadCount Желаният брой нишки; 0 избира автоматично.
+ * @return 1 под `PARALLEL_SORT_THRESHOLD`, иначе броя на ядрата (или `threadCount`, ако е зададен).
+ */
+inline int chooseSortThreadCount(size_t size, int threadCount) {
+    if (threadCount > 0) {
+        return threadCount;
+    }
+    if (size < PARALLEL_SORT_THRESHOLD) {
+        return 1;
+    }
+    return std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Брой елементи, над който `sortSlotsByKey` използва поразрядно сортиране (radix sort).
+ */
+const size_t RADIX_SORT_THRESHOLD = 4096;
+
+/**
+ * @brief Начин на сортиране в `sortSlotsByKey`.
+ */
+enum SortMethod {
+    SORT_METHOD_AUTO,       /**< Поразрядно над `RADIX_SORT_THRESHOLD`, иначе чрез сравнения. */
+    SORT_METHOD_COMPARISON, /**< Винаги чрез сравнения (`parallelSort`). */
+    SORT_METHOD_RADIX       /**< Винаги поразрядно (`radixSortSlots`). */
+};
+
+/**
+ * @brief Сортира интервала `[first, last)` чрез вмъкване.
+ */
+template <typename T, typename Less>
+void insertionSort(T* first, T* last, Less less) {
+    for (T* current = first + 1; current < last; current++) {
+        T value = std::move(*current);
+        T* hole = current;
+        while (hole > first && less(value, hole[-1])) {
+            *hole = std::move(hole[-1]);
+            hole--;
+        }
+        *hole = std::move(value);
+    }
+}
+
+/**
+ * @brief Поставя медианата на `a`, `b` и `c` на позиция `result`.
+ */
+template <typename T, typename Less>
+void moveMedianToFirst(T* result, T* a, T* b, T* c, Less less) {
+    if (less(*a, *b)) {
+        if (less(*b, *c)) std::iter_swap(result, b);
+        else if (less(*a, *c)) std::iter_swap(result, c);
+        else std::iter_swap(result, a);
+    } else if (less(*a, *c)) {
+        std::iter_swap(result, a);
+    } else if (less(*b, *c)) {
+        std::iter_swap(result, c);
+    } else {
+        std::iter_swap(result, b);
+    }
+}
+
+/**
+ * @brief Разделя `[first, last)` около опората `*pivot` по схемата на Хоар.
+ * @return Началото на дясната част.
+ *
+ * Елементите, равни на опората, се разпределят в двете части, така че много
+ * повтарящи се ключове не водят до квадратично време.
+ */
+template <typename T, typename Less>
+T* unguardedPartition(T* first, T* last, T* pivot, Less less) {
+    while (true) {
+        while (less(*first, *pivot)) first++;
+        last--;
+        while (less(*pivot, *last)) last--;
+        if (!(first < last)) return first;
+        std::iter_swap(first, last);
+        first++;
+    }
+}
+
+/**
+ * @brief Основен цикъл на introsort.
+ *
+ * Рекурсията продължава само в по-малката част, а по-голямата се обработва в цикъла,
+ * затова дълбочината на стека е O(log n). При изчерпване на `depthLimit` интервалът
+ * се сортира пирамидално, което ограничава най-лошия случай до O(n log n).
+ */
+template <typename T, typename Less>
+void introSortLoop(T* first, T* last, int depthLimit, Less less) {
+    while (last - first > INSERTION_SORT_THRESHOLD) {
+        if (depthLimit == 0) {
+            std::make_heap(first, last, less);
+            std::sort_heap(first, last, less);
+            return;
+        }
+        depthLimit--;
+
+        moveMedianToFirst(first, first + 1, first + (last - first) / 2, last - 1, less);
+        T* cut = unguardedPartition(first + 1, last, first, less);
+
+        if (cut - first < last - cut) {
+            introSortLoop(first, cut, depthLimit, less);
+            first = cut;
+        } else {
+            introSortLoop(cut, last, depthLimit, less);
+            last = cut;
+        }
+    }
+    insertionSort(first, last, less);
+}
+
+/**
+ * @brief Сортира `[first, last)` на място чрез introsort. Сортирането не е стабилно.
+ * @param less Строг слаб ред, например `EncodedKeysLess<...>` или ламбда функция.
+ *
+ * Вече сортиран вход се разпознава с едно линейно обхождане и не се пренарежда.
+ */
+template <typename T, typename Less>
+void introSort(T* first, T* last, Less less) {
+    if (last - first < 2 || std::is_sorted(first, last, less)) {
+        return;
+    }
+    int depthLimit = 0;
+    for (auto n = last - first; n > 1; n >>= 1) {
+        depthLimit += 2;
+    }
+    introSortLoop(first, last, depthLimit, less);
+}
+
+/**
+ * @brief Сортира `[first, last)` стабилно: елементите с равни ключове запазват реда си.
+ * @param less Строг слаб ред, например `EncodedKeysLess<...>` или ламбда функция.
+ *
+ * Използва сливане отдолу нагоре с допълнителен буфер с размера на входа, като
+ * първоначалните серии с дължина `INSERTION_SORT_THRESHOLD` се сортират чрез вмъкване.
+ */
+template <typename T, typename Less>
+void stableSort(T* first, T* last, Less less) {
+    auto size = last - first;
+    if (size < 2 || std::is_sorted(first, last, less)) {
+        return;
+    }
+
+    for (auto start = 0; start < size; start += INSERTION_SORT_THRESHOLD) {
+        insertionSort(first + start, first + std::min<decltype(size)>(start + INSERTION_SORT_THRESHOLD, size), less);
+    }
+
+    std::vector<T> buffer(first, last);
+    T* source = first;
+    T* target = buffer.data();
+    for (decltype(size) width = INSERTION_SORT_THRESHOLD; width < size; width *= 2) {
+        for (decltype(size) start = 0; start < size; start += 2 * width) {
+            auto middle = std::min(start + width, size);
+            auto end = std::min(start + 2 * width, size);
+            std::merge(source + start, source + middle, source + middle, source + end, target + start, less);
+        }
+        std::swap(source, target);
+    }
+    if (source != first) {
+        std::move(source, source + size, first);
+    }
+}
+
+/**
+ * @brief Сортира `[first, last)` на няколко нишки.
+ * @param less Строг слаб ред, например `EncodedKeysLess<...>` или ламбда функция.
+ * @param threadCount Брой нишки; при 1 или при малко елементи се използва `introSort`.
+ *
+ * Интервалът се разделя на `threadCount` равни части, всяка част се сортира чрез `introSort`
+ * в отделна нишка, след което съседните части се сливат по двойки, отново паралелно,
+ * докато не остане една. Сливането използва допълнителен буфер с размера на входа.
+ * Когато `less` е пълна наредба (няма различни елементи, които са равни), резултатът
+ * съвпада с този на `introSort`.
+ */
+template <typename T, typename Less>
+void parallelSort(T* first, T* last, Less less, int threadCount) {
+    size_t size = last - first;
+    if (threadCount <= 1 || size < (size_t)threadCount * INSERTION_SORT_THRESHOLD) {
+        introSort(first, last, less);
+        return;
+    }
+
+    std::vector<size_t> bounds;
+    for (int i = 0; i <= threadCount; i++) {
+        bounds.push_back(size * i / threadCount);
+    }
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threadCount; i++) {
+        workers.emplace_back([first, &bounds, less, i]() {
+            introSort(first + bounds[i], first + bounds[i + 1], less);
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    std::vector<T> buffer(size);
+    T* source = first;
+    T* target = buffer.data();
+    while (bounds.size() > 2) {
+        std::vector<size_t> merged;
+        workers.clear();
+        for (size_t i = 0; i + 1 < bounds.size(); i += 2) {
+            merged.push_back(bounds[i]);
+            if (i + 2 < bounds.size()) {
+                workers.emplace_back([source, target, &bounds, less, i]() {
+                    std::merge(source + bounds[i], source + bounds[i + 1], source + bounds[i + 1], source + bounds[i + 2],
+                               target + bounds[i], less);
+                });
+            } else {
+                std::copy(source + bounds[i], source + bounds[i + 1], target + bounds[i]);
+            }
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        merged.push_back(size);
+        bounds.swap(merged);
+        std::swap(source, target);
+    }
+    if (source != first) {
+        std::copy(source, source + size, first);
+    }
+}
+
+/**
+ * @brief Двойка от извлечен ключ за сортиране и позицията на имота, от който е взет.
  *
- * Това е основната входна точка за сортиране на имоти. В момента сортира по цена.
- * Реализацията вътрешно извиква `quickSort` след инициализиране на процеса на сортиране.
+ * Сортират се тези малки двойки вместо целите записи `Property`, а след това
+ * от тях се взема само новият ред на позициите.
  */
-void sortPropertiesArray(struct Property arr[], int size, bool sortAscending);
+template <typename K>
+struct SlotKey {
+    K key;
+    uint32_t slot;
+};
 
 /**
- * @brief Разделя масива около елемент на опора (pivot).
- * @param arr Масивът, който ще бъде разделен.
- * @param low Началният индекс на подмасива за разделяне.
- * @param high Крайният индекс на подмасива за разделяне.
- * @param sortAscending Булев флаг, указващ реда на сортиране (true за възходящ).
- * @return Индексът на елемента на опора след разделянето.
+ * @brief Брой битове на ключа, обработвани при един проход на поразрядното сортиране.
  *
- * Това е помощна функция за алгоритъма QuickSort, която пренарежда елементите
- * така, че елементи, по-малки (или по-големи, в зависимост от реда на сортиране) от pivot,
- * да идват преди (или след) него.
+ * С 11 бита 64-битов ключ се сортира с 6 прохода вместо 8, а броячите на един проход
+ * (2048 елемента) все още се побират в кеша L1.
  */
-int partition(struct Property arr[], int low, int high, bool sortAscending);
+const int RADIX_DIGIT_BITS = 11;
+const int RADIX_BUCKETS = 1 << RADIX_DIGIT_BITS;
 
 /**
- * @brief Реализира алгоритъма QuickSort за сортиране на масив от структури Property.
- * @param arr Масивът от структури Property, който ще бъде сортиран.
- * @param low Началният индекс на подмасива за сортиране.
- * @param high Крайният индекс на подмасива за сортиране.
- * @param sortAscending Булев флаг, указващ реда на сортиране (true за възходящ).
+ * @brief Преобразува число с плаваща запетая в цяло число без знак със същата наредба.
  *
- * Тази рекурсивна функция ефективно сортира имотите на място въз основа на
- * избрания критерий (в момента цена).
+ * При положителните числа се вдига знаковият бит, а при отрицателните се обръщат всички битове,
+ * така че сравнението на резултатите като цели числа съвпада със сравнението на стойностите.
+ * -0.0 се приравнява на 0.0, както е и при операторите за сравнение.
  */
-void quickSort(struct Property arr[], int low, int high, bool sortAscending);
+inline uint64_t radixKey(double value) {
+    if (value == 0) {
+        value = 0.0;
+    }
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits >> 63) ? ~bits : bits | ((uint64_t)1 << 63);
+}
+
+/**
+ * @brief Преобразува цяло число със знак в цяло число без знак със същата наредба.
+ */
+inline uint32_t radixKey(int value) {
+    return (uint32_t)value ^ 0x80000000u;
+}
+
+/**
+ * @brief Пренарежда позициите `[first, last)` според стойностите им в `keys` чрез поразрядно сортиране.
+ * @param keys Колона с ключове (`double` или `int`), индексирана по позиция.
+ * @param sortAscending true за възходящ ред, false за низходящ.
+ *
+ * Сортират се двойки (преобразуван ключ, позиция) по `RADIX_DIGIT_BITS` бита на проход, от най-младшите
+ * към най-старшите (LSD), за линейно време. При низходящ ред битовете на ключа се обръщат.
+ * Броячите за всички проходи се събират с едно обхождане, а проходите по цифри, които са
+ * еднакви за всички ключове (например старшите битове на броя стаи), се пропускат.
+ * Сортирането е стабилно: позициите с равни ключове запазват реда си от входа.
+ */
+template <typename K>
+void radixSortSlots(uint32_t* first, uint32_t* last, const K* keys, bool sortAscending) {
+    typedef decltype(radixKey(K())) RadixKey;
+    const int digitCount = (sizeof(RadixKey) * 8 + RADIX_DIGIT_BITS - 1) / RADIX_DIGIT_BITS;
+    size_t size = last - first;
+    if (size < 2) {
+        return;
+    }
+
+    std::vector<SlotKey<RadixKey>> items(size);
+    std::vector<size_t> counts(digitCount * RADIX_BUCKETS, 0);
+    RadixKey flip = sortAscending ? 0 : ~(RadixKey)0;
+    for (size_t i = 0; i < size; i++) {
+        RadixKey key = radixKey(keys[first[i]]) ^ flip;
+        items[i].key = key;
+        items[i].slot = first[i];
+        for (int digit = 0; digit < digitCount; digit++) {
+            counts[digit * RADIX_BUCKETS + ((key >> (digit * RADIX_DIGIT_BITS)) & (RADIX_BUCKETS - 1))]++;
+        }
+    }
+
+    std::vector<SlotKey<RadixKey>> buffer(size);
+    std::vector<size_t> offsets(RADIX_BUCKETS);
+    SlotKey<RadixKey>* source = items.data();
+    SlotKey<RadixKey>* target = buffer.data();
+    for (int digit = 0; digit < digitCount; digit++) {
+        size_t* digitCounts = &counts[digit * RADIX_BUCKETS];
+        int shift = digit * RADIX_DIGIT_BITS;
+        if (digitCounts[(source[0].key >> shift) & (RADIX_BUCKETS - 1)] == size) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (int value = 0; value < RADIX_BUCKETS; value++) {
+            offsets[value] = offset;
+            offset += digitCounts[value];
+        }
+        for (size_t i = 0; i < size; i++) {
+            target[offsets[(source[i].key >> shift) & (RADIX_BUCKETS - 1)]++] = source[i];
+        }
+        std::swap(source, target);
+    }
+
+    for (size_t i = 0; i < size; i++) {
+        first[i] = source[i].slot;
+    }
+}
 
 /**
- * @brief Разменя местата на две структури Property.
- * @param a Указател към първата структура Property.
- * @param b Указател към втората структура Property.
+ * @brief Пренарежда позициите `[first, last)` според стойностите им в колоната `keys`.
+ * @param keys Колона с ключове, индексирана по позиция, например `store.prices()`.
+ * @param sortAscending true за възходящ ред, false за низходящ.
+ * @param threadCount Брой нишки при сортиране чрез сравнения; 0 избира автоматично чрез `chooseSortThreadCount`.
+ * @param method Начин на сортиране; `SORT_METHOD_AUTO` избира `radixSortSlots` над `RADIX_SORT_THRESHOLD`
+ *        позиции, ако входните позиции са във възходящ ред.
+ *
+ * Ключовете се извличат веднъж в масив от `SlotKey`, така че сравненията не обръщат
+ * към колоната на случайни адреси. При равни ключове по-малката позиция е първа,
+ * т.е. имотите запазват реда си в каталога. Тъй като няма две равни двойки,
+ * паралелното сортиране дава същия ред като последователното. Поразрядното сортиране
+ * е стабилно, затова при възходящ вход също дава същия ред.
+ */
+template <typename K>
+void sortSlotsByKey(uint32_t* first, uint32_t* last, const K* keys, bool sortAscending, int threadCount = 0,
+                    SortMethod method = SORT_METHOD_AUTO) {
+    if (method == SORT_METHOD_RADIX ||
+        (method == SORT_METHOD_AUTO && (size_t)(last - first) >= RADIX_SORT_THRESHOLD && std::is_sorted(first, last))) {
+        radixSortSlots(first, last, keys, sortAscending);
+        return;
+    }
+
+    std::vector<SlotKey<K>> pairs(last - first);
+    for (size_t i = 0; i < pairs.size(); i++) {
+        pairs[i].key = keys[first[i]];
+        pairs[i].slot = first[i];
+    }
+
+    SlotKey<K>* begin = pairs.data();
+    SlotKey<K>* end = begin + pairs.size();
+    threadCount = chooseSortThreadCount(pairs.size(), threadCount);
+    if (sortAscending) {
+        parallelSort(begin, end, [](const SlotKey<K>& a, const SlotKey<K>& b) {
+            return a.key < b.key || (a.key == b.key && a.slot < b.slot);
+        }, threadCount);
+    } else {
+        parallelSort(begin, end, [](const SlotKey<K>& a, const SlotKey<K>& b) {
+            return b.key < a.key || (a.key == b.key && a.slot < b.slot);
+        }, threadCount);
+    }
+
+    for (size_t i = 0; i < pairs.size(); i++) {
+        first[i] = pairs[i].slot;
+    }
+}
+
+/**
+ * @brief Избира K-те позиции с най-големи (или най-малки) ключове с едно обхождане.
+ *
+ * Кандидатите се подават един по един чрез `offer`. Пази се ограничена пирамида
+ * от най-много K двойки `SlotKey`, на чийто връх е най-слабият избран кандидат,
+ * така че всеки следващ кандидат се сравнява само с него и се вмъква за O(log K)
+ * само ако е по-добър. Общата сложност е O(n log K) при O(K) памет.
+ * При равни ключове по-малката позиция е по-добра, т.е. имотите запазват реда си в каталога.
+ */
+template <typename K>
+class TopKSelector {
+public:
+    /**
+     * @param limit Броят K на позициите за избор.
+     * @param largest true за най-големите ключове, false за най-малките.
+     */
+    TopKSelector(size_t limit, bool largest) : limit(limit), largest(largest) {
+        heap.reserve(limit);
+    }
+
+    /**
+     * @brief Предлага позиция `slot` с ключ `key` като кандидат.
+     */
+    void offer(K key, uint32_t slot) {
+        SlotKey<K> candidate = {key, slot};
+        Better better = {largest};
+        if (heap.size() < limit) {
+            heap.push_back(candidate);
+            std::push_heap(heap.begin(), heap.end(), better);
+        } else if (limit > 0 && better(candidate, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), better);
+            heap.back() = candidate;
+            std::push_heap(heap.begin(), heap.end(), better);
+        }
+    }
+
+    /**
+     * @brief Връща избраните позиции, като най-добрата е първа.
+     */
+    std::vector<uint32_t> slots() const {
+        std::vector<SlotKey<K>> ordered(heap);
+        std::sort_heap(ordered.begin(), ordered.end(), Better{largest});
+        std::vector<uint32_t> result(ordered.size());
+        for (size_t i = 0; i < ordered.size(); i++) {
+            result[i] = ordered[i].slot;
+        }
+        return result;
+    }
+
+private:
+    /**
+     * @brief Проверява дали `a` е по-добър кандидат от `b`; като сравнение на пирамидата
+     * поставя най-слабия кандидат на върха.
+     */
+    struct Better {
+        bool largest;
+
+        bool operator()(const SlotKey<K>& a, const SlotKey<K>& b) const {
+            if (a.key != b.key) {
+                return largest ? b.key < a.key : a.key < b.key;
+            }
+            return a.slot < b.slot;
+        }
+    };
+
+    size_t limit;
+    bool largest;
+    std::vector<SlotKey<K>> heap;
+};
+
+/**
+ * @brief Най-голям брой критерии за `sortSlotsByFields`.
+ */
+const int MAX_SORT_CRITERIA = 4;
+
+/**
+ * @brief Позиция на имот заедно с ключовете си за сортиране по няколко полета.
+ * @tparam KeyCount Броят на критериите.
+ *
+ * Всеки ключ е кодиран като 64-битово цяло число без знак, чиято наредба съвпада с търсения
+ * ред по съответния критерий, включително посоката му.
+ */
+template <int KeyCount>
+struct EncodedSlot {
+    uint64_t keys[KeyCount];
+    uint32_t slot;
+};
+
+/**
+ * @brief Лексикографско сравнение на кодираните ключове: всеки следващ ключ се проверява само при равенство по предходните.
+ *
+ * Броят на ключовете е параметър на шаблона, така че цикълът се разгъва от компилатора.
+ */
+template <int KeyCount>
+struct EncodedKeysLess {
+    bool operator()(const EncodedSlot<KeyCount>& a, const EncodedSlot<KeyCount>& b) const {
+        for (int i = 0; i < KeyCount; i++) {
+            if (a.keys[i] != b.keys[i]) {
+                return a.keys[i] < b.keys[i];
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Връща ранга на всеки идентификатор от речника в азбучния ред на низовете.
+ * @param dictionary Речникът.
+ * @return Масив с `dictionary.size()` елемента: рангът на идентификатора `id` е на позиция `id`.
+ *
+ * Така текстови стойности се сравняват по азбучен ред чрез сравнение на цели числа.
+ */
+std::vector<uint32_t> dictionaryRanks(const StringDictionary& dictionary);
+
+/**
+ * @brief Пренарежда позиции на имоти по няколко полета, например район, после цена низходящо, после обща площ.
+ * @param store Контейнерът, от чиито колони се вземат ключовете.
+ * @param slots Позициите, които да бъдат пренаредени.
+ * @param criteria Между 1 и `MAX_SORT_CRITERIA` критерия по приоритет; излишните се пренебрегват.
+ * @param stable true за `stableSort`: позициите, равни по всички критерии, запазват реда си от входа;
+ *        false за по-бързия `introSort` без тази гаранция.
+ *
+ * Ключовете се извличат от колоните веднъж за всяка позиция. Числовите полета се кодират
+ * чрез `radixKey`, а текстовите - чрез ранга на идентификатора им в азбучно подредения речник,
+ * така че сравнението на текст също е сравнение на цели числа. При низходящ ред битовете
+ * на ключа се обръщат.
+ */
+void sortSlotsByFields(const PropertyStore& store, std::vector<uint32_t>& slots, const std::vector<SortCriterion>& criteria,
+                       bool stable);
+
+/**
+ * @brief Пренарежда списък с позиции на имоти по цена.
+ * @param store Контейнерът, от който се вземат цените.
+ * @param slots Позициите, които да бъдат пренаредени.
+ * @param sortAscending Булев флаг: true за възходящ ред, false за низходящ.
+ * @param threadCount Брой нишки; 0 избира автоматично (паралелно над `PARALLEL_SORT_THRESHOLD` позиции).
  *
- * Помощна функция, използвана от алгоритъма за сортиране за размяна на позициите на елементи.
+ * Самите имоти не се копират и не се местят: резултатът е пермутация на позициите,
+ * по която се показват. Имотите с еднаква цена запазват реда си в каталога.
  */
-void swap(struct Property* a, struct Property* b);
+void sortSlotsByPrice(const PropertyStore& store, std::vector<uint32_t>& slots, bool sortAscending, int threadCount = 0);
 
-#endif 
+#endif
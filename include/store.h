@@ -0,0 +1,375 @@
+/**
+ * @file store.h
+ * @brief Този файл декларира контейнера PropertyStore, в който се съхраняват всички имоти в паметта.
+ *
+ * PropertyStore замества фиксирания масив `Property[MAX_PROPERTIES]` и расте динамично,
+ * без горна граница за броя на имотите. Всички модули (добавяне, изтриване, актуализиране,
+ * търсене, отчети, показване и файлови операции) работят през неговия интерфейс.
+ */
+
+#ifndef STORE_H
+#define STORE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "structs.h"
+#include "index.h"
+#include "dictionary.h"
+
+/**
+ * @brief Числови полета, по които PropertyStore поддържа подредени индекси за търсене по интервал.
+ */
+enum RangeField {
+    RANGE_PRICE,
+    RANGE_TOTAL_AREA,
+    RANGE_FLOOR,
+    RANGE_ROOMS,
+    RANGE_FIELD_COUNT
+};
+
+/**
+ * @brief Полета, по които може да бъде сортиран целият каталог чрез `PropertyStore::sortByFields`.
+ */
+enum SortField {
+    SORT_FIELD_REF_NUMBER,
+    SORT_FIELD_BROKER,
+    SORT_FIELD_TYPE,
+    SORT_FIELD_AREA,
+    SORT_FIELD_EXPOSITION,
+    SORT_FIELD_PRICE,
+    SORT_FIELD_TOTAL_AREA,
+    SORT_FIELD_ROOMS,
+    SORT_FIELD_FLOOR,
+    SORT_FIELD_STATUS,
+    SORT_FIELD_COUNT
+};
+
+/**
+ * @brief Един критерий за сортиране: поле и посока.
+ */
+struct SortCriterion {
+    SortField field;
+    bool ascending;
+};
+
+/**
+ * @brief Непритежаващ изглед към последователност от позиции в PropertyStore.
+ *
+ * Резултатите от търсене се подават на функциите за показване и запис като `SlotSpan`,
+ * без да се копират нито позициите, нито самите имоти. Изгледът се създава от `std::vector`
+ * или от указател и брой и е валиден, докато съществува масивът, към който сочи.
+ */
+struct SlotSpan {
+    const uint32_t* first;
+    size_t count;
+
+    SlotSpan(const uint32_t* first, size_t count) : first(first), count(count) {}
+    SlotSpan(const std::vector<uint32_t>& slots) : first(slots.data()), count(slots.size()) {}
+
+    const uint32_t* begin() const { return first; }
+    const uint32_t* end() const { return first + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    uint32_t operator[](size_t i) const { return first[i]; }
+};
+
+/**
+ * @brief Обобщени стойности за имотите в един район.
+ */
+struct AreaAggregate {
+    int count;
+    double totalPrice;
+    int mostExpensiveSlot;
+};
+
+/**
+ * @brief Динамично нарастващ контейнер за имотите в системата.
+ *
+ * Имотите се адресират чрез позиция (slot) от 0 до `size() - 1`. Редът на позициите
+ * съвпада с реда, в който имотите се показват и записват във файловете.
+ * Контейнерът поддържа хеш индекс по референтен номер, индекси по брокер, по брой стаи
+ * и по район, подредени по цена, сумите на цените по райони и подредени индекси по цена,
+ * обща площ, етаж и брой стаи. Те се актуализират при всяка промяна, така че
+ * `findByRefNumber`, `findByBroker`, `findByRooms`, `findInRange` и `areaAggregate`
+ * не обхождат целия каталог.
+ *
+ * Данните се съхраняват по колони (struct-of-arrays): всяко числово поле е в отделен
+ * непрекъснат масив. Така обхождания, които четат само цена, площ, стаи, етаж или статус,
+ * не зареждат в кеша целите записи. `get` сглобява пълна структура `Property`
+ * за код, който показва или записва имоти.
+ *
+ * Текстовите полета (брокер, тип, район, изложение) са кодирани чрез речници:
+ * колоните пазят 32-битови идентификатори, а всяка различна стойност се съхранява
+ * веднъж в съответния `StringDictionary`. Филтрите по тези полета сравняват идентификатори.
+ */
+class PropertyStore {
+public:
+    /**
+     * @brief Връща броя на имотите в контейнера.
+     */
+    int size() const;
+
+    /**
+     * @brief Проверява дали контейнерът е празен.
+     * @return true, ако няма нито един имот, в противен случай false.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Заделя предварително памет за указания брой имоти.
+     * @param capacity Очакваният брой имоти.
+     *
+     * Използва се при зареждане от файл, когато броят на записите е известен предварително,
+     * за да се избегнат многократни преразпределения на паметта.
+     */
+    void reserve(int capacity);
+
+    /**
+     * @brief Премахва всички имоти от контейнера.
+     */
+    void clear();
+
+    /**
+     * @brief Проверява дали имотът може да бъде записан в контейнера.
+     * @return true, ако цената и общата площ са крайни числа.
+     *
+     * Подредените индекси и обобщените стойности по райони изискват крайни ключове:
+     * `nan` нарушава подредбата на списъците, а сумата на района не може да бъде
+     * възстановена след него. Затова `add`, `append` и `update` отхвърлят такива имоти.
+     */
+    static bool isStorable(const Property& property);
+
+    /**
+     * @brief Добавя нов имот в края на контейнера.
+     * @param property Имотът, който да бъде добавен.
+     * @return Позицията, на която е записан новият имот, или -1, ако `isStorable` е false
+     * (тогава контейнерът не се променя).
+     */
+    int add(const Property& property);
+
+    /**
+     * @brief Добавя имот в края на контейнера при масово зареждане.
+     * @param property Имотът, който да бъде добавен.
+     * @return Позицията, на която е записан новият имот, или -1, ако `isStorable` е false.
+     *
+     * За разлика от `add`, подредените индекси само се допълват в края и се подреждат
+     * наведнъж от `finishAppend`. Индексът по референтен номер се поддържа веднага,
+     * затова `findByRefNumber` работи и по време на зареждането. Всички останали търсения
+     * и промени са валидни едва след `finishAppend`.
+     */
+    int append(const Property& property);
+
+    /**
+     * @brief Подрежда индексите след поредица от `append`, с едно сортиране на всеки списък.
+     */
+    void finishAppend();
+
+    /**
+     * @brief Премахва имота на дадена позиция, запазвайки реда на останалите.
+     * @param slot Позицията на имота за премахване.
+     */
+    void remove(int slot);
+
+    /**
+     * @brief Сглобява и връща имота на дадена позиция.
+     * @param slot Позицията на имота.
+     * @return Копие на имота като структура `Property`.
+     */
+    Property get(int slot) const;
+
+    /**
+     * @brief Връща изглед към имота на дадена позиция, без да копира текстовите полета.
+     * @param slot Позицията на имота.
+     * @return Изглед, чиито текстови полета сочат към речниците на контейнера.
+     *
+     * Изгледът е валиден до следващата промяна на контейнера. Използва се за показване
+     * и запис на имоти вместо `get`, който копира четирите текстови полета.
+     */
+    PropertyView view(int slot) const;
+
+    /**
+     * @brief Замества данните на имота на дадена позиция.
+     * @param slot Позицията на имота.
+     * @param property Новите данни на имота.
+     * @return false, ако `isStorable` е false; тогава имотът остава непроменен.
+     */
+    bool update(int slot, const Property& property);
+
+    /**
+     * @brief Търси позицията на имот по неговия референтен номер чрез хеш индекса.
+     * @param refNumber Търсеният референтен номер.
+     * @return Позицията на имота или -1, ако не е намерен.
+     */
+    int findByRefNumber(int refNumber) const;
+
+    /**
+     * @brief Връща позициите на имотите на даден брокер, подредени по цена, чрез индекса по брокер.
+     * @param brokerId Идентификаторът на брокера в `brokers()`.
+     * @param sortAscending true за възходящ ред по цена, false за низходящ.
+     * @return Позициите; имотите с еднаква цена са в реда си в каталога.
+     *
+     * Сложността е O(брой резултати): списъкът на брокера се поддържа подреден по цена.
+     */
+    std::vector<uint32_t> findByBroker(uint32_t brokerId, bool sortAscending) const;
+
+    /**
+     * @brief Връща броя на имотите на даден брокер за O(1) чрез индекса по брокер.
+     */
+    size_t countByBroker(uint32_t brokerId) const;
+
+    /**
+     * @brief Връща позициите на имотите с даден брой стаи, подредени по цена, чрез индекса по брой стаи.
+     * @param roomsCount Търсеният брой стаи.
+     * @param sortAscending true за възходящ ред по цена, false за низходящ.
+     * @return Позициите; имотите с еднаква цена са в реда си в каталога.
+     *
+     * Сложността е O(брой резултати): всяка група по брой стаи се поддържа подредена по цена.
+     */
+    std::vector<uint32_t> findByRooms(int roomsCount, bool sortAscending) const;
+
+    /**
+     * @brief Връща позициите на имотите, чиято стойност на дадено поле е в затворения интервал `[low, high]`.
+     * @param field Полето (цена, обща площ, етаж или брой стаи).
+     * @param low Долната граница.
+     * @param high Горната граница.
+     * @return Позициите във възходящ ред по стойността на полето, а при равни стойности - по позиция.
+     *
+     * Сложността е O(log n + брой резултати) чрез подредения индекс по полето.
+     */
+    std::vector<uint32_t> findInRange(RangeField field, double low, double high) const;
+
+    /**
+     * @brief Връща броя на имотите, чиято стойност на дадено поле е в `[low, high]`, за O(log n).
+     */
+    size_t countInRange(RangeField field, double low, double high) const;
+
+    /**
+     * @brief Връща позициите на имотите с най-големите (или най-малките) стойности на дадено поле.
+     * @param field Полето (цена, обща площ, етаж или брой стаи).
+     * @param count Най-много колко позиции да бъдат върнати.
+     * @param largest true за най-големите стойности (в низходящ ред), false за най-малките (във възходящ).
+     * @return Позициите; при равни стойности - в реда им в каталога.
+     *
+     * Сложността е O(count): позициите се вземат от края или началото на подредения индекс по полето.
+     */
+    std::vector<uint32_t> findTop(RangeField field, size_t count, bool largest) const;
+
+    /**
+     * @brief Връща броя, сумата на цените и най-скъпия имот в даден район.
+     * @param areaId Идентификаторът на района в `areas()`.
+     * @return Обобщените стойности; при район без имоти броят е 0, а `mostExpensiveSlot` е -1.
+     *
+     * Броят и сумата се поддържат при всяка промяна и се връщат за O(1). Най-скъпият имот
+     * е в края на списъка на района, който се поддържа подреден по цена при всяка промяна,
+     * и се намира за O(log брой имоти в района) без сортиране; при еднаква цена това е
+     * имотът с най-малка позиция.
+     */
+    AreaAggregate areaAggregate(uint32_t areaId) const;
+
+    /**
+     * @brief Връща позициите на имотите в даден район, подредени по цена, чрез индекса по район.
+     * @param areaId Идентификаторът на района в `areas()`.
+     * @param sortAscending true за възходящ ред по цена, false за низходящ.
+     * @param limit Най-много колко позиции да бъдат върнати.
+     * @return Позициите; имотите с еднаква цена са в реда си в каталога.
+     */
+    std::vector<uint32_t> findByArea(uint32_t areaId, bool sortAscending, size_t limit = SIZE_MAX) const;
+
+    /**
+     * @brief Връща точния квантил на цените в даден район чрез индекса по район.
+     * @param areaId Идентификаторът на района в `areas()`.
+     * @param fraction Делът в `[0, 1]`, например 0.5 за медианата или 0.9 за 90-ия персентил.
+     * @return Цената с ранг `quantileRank(fraction, брой)` във възходящ ред; 0 при район без имоти.
+     *
+     * Списъкът на района остава подреден по цена при всяко добавяне, промяна и изтриване,
+     * защото единичните промени го допълват чрез двоично търсене, а масовото зареждане
+     * го подрежда веднага в `finishAppend`. Затова квантилът се взема по ранг за O(1),
+     * без сортиране и без обхождане на каталога.
+     */
+    double areaPriceQuantile(uint32_t areaId, double fraction) const;
+
+    /**
+     * @brief Проверява поддържаните обобщени стойности по райони спрямо изчислени наново от колоните.
+     * @return true, ако всички цени и площи са крайни числа и броят, сумата (с относителна
+     *         грешка до 1e-9) и най-скъпият имот съвпадат за всеки район.
+     *
+     * Предназначена е за отстраняване на грешки и тестове: обхожда целия каталог.
+     */
+    bool verifyAreaAggregates() const;
+
+    /**
+     * @brief Сортира имотите по цена и възстановява индексите спрямо новия ред.
+     * @param sortAscending true за възходящ ред, false за низходящ.
+     */
+    void sortByPrice(bool sortAscending);
+
+    /**
+     * @brief Сортира имотите по няколко полета и възстановява индексите спрямо новия ред.
+     * @param criteria Критериите по приоритет (виж `sortSlotsByFields`).
+     * @param stable true, за да запазят имотите, равни по всички критерии, реда си в каталога.
+     */
+    void sortByFields(const std::vector<SortCriterion>& criteria, bool stable);
+
+    /**
+     * @brief Колони с числовите полета. Всяка колона съдържа `size()` елемента.
+     */
+    const int* refNumbers() const;
+    const double* prices() const;
+    const double* totalAreas() const;
+    const int* rooms() const;
+    const int* floors() const;
+    const unsigned char* statuses() const;
+
+    /**
+     * @brief Колони с идентификатори на текстовите полета, кодирани чрез съответния речник.
+     */
+    const uint32_t* brokerIds() const;
+    const uint32_t* typeIds() const;
+    const uint32_t* areaIds() const;
+    const uint32_t* expositionIds() const;
+
+    /**
+     * @brief Речници за текстовите полета.
+     *
+     * Речниците само нарастват, докато контейнерът не бъде изчистен, затова могат
+     * да съдържат стойности, които вече не се използват от нито един имот.
+     */
+    const StringDictionary& brokers() const;
+    const StringDictionary& types() const;
+    const StringDictionary& areas() const;
+    const StringDictionary& expositions() const;
+
+private:
+    int pushColumns(const Property& property);
+    void permute(const std::vector<uint32_t>& order);
+    void rebuildIndexes();
+    double rangeKey(int field, int slot) const;
+    void addToAreaSum(uint32_t areaId, double price);
+    void removeFromAreaSum(uint32_t areaId, double price);
+
+    std::vector<int> refNumberColumn;
+    std::vector<double> priceColumn;
+    std::vector<double> totalAreaColumn;
+    std::vector<int> roomsColumn;
+    std::vector<int> floorColumn;
+    std::vector<unsigned char> statusColumn;
+    std::vector<uint32_t> brokerColumn;
+    std::vector<uint32_t> typeColumn;
+    std::vector<uint32_t> areaColumn;
+    std::vector<uint32_t> expositionColumn;
+
+    StringDictionary brokerDictionary;
+    StringDictionary typeDictionary;
+    StringDictionary areaDictionary;
+    StringDictionary expositionDictionary;
+
+    RefNumberIndex refIndex;
+    PostingIndex brokerIndex;
+    PostingIndex roomsIndex;
+    PostingIndex areaIndex;
+    std::vector<double> areaPriceSums;
+    SortedSlotList rangeIndexes[RANGE_FIELD_COUNT];
+};
+
+#endif
@@ -11,9 +11,6 @@
 
 #include <string>
 
-
-#define MAX_PROPERTIES 100
-
 /**
  * @brief Изброява възможните статуси на недвижим имот.
  *
@@ -46,4 +43,34 @@ struct Property {
     enum Status status; 
 };
 
+/**
+ * @brief Изглед само за четене към един имот, без копиране на текстовите полета.
+ *
+ * Полетата имат същите имена като в `Property`, но текстовите са указатели към низове,
+ * които принадлежат на друг обект (речниците на PropertyStore или структура `Property`).
+ * Изгледът е валиден, докато този обект не бъде променен.
+ */
+struct PropertyView {
+    int refNumber;
+    const char* broker;
+    const char* type;
+    const char* area;
+    const char* exposition;
+    double price;
+    double totalArea;
+    int rooms;
+    int floor;
+    enum Status status;
+
+    PropertyView() = default;
+
+    /**
+     * @brief Създава изглед към полетата на структура `Property`.
+     */
+    PropertyView(const Property& property)
+        : refNumber(property.refNumber), broker(property.broker), type(property.type), area(property.area),
+          exposition(property.exposition), price(property.price), totalArea(property.totalArea),
+          rooms(property.rooms), floor(property.floor), status(property.status) {}
+};
+
 #endif 
@@ -11,6 +11,7 @@
 #define UPDATE_H
 
 #include "structs.h" 
+#include "store.h"
 #include <iostream>  
 #include <limits>    
 
@@ -19,35 +20,32 @@
 
 /**
  * @brief Основна функция за актуализиране на детайлите на съществуващ имот.
- * @param properties Масив от структури Property.
- * @param propertyCount Текущият брой имоти в системата.
+ * @param store Контейнерът с имоти в системата.
  *
  * Тази функция подканва потребителя да въведе референтен номер, търси имота
  * и след това позволява на потребителя да избере кои полета да актуализира.
  */
-void updateProperty(Property properties[], int& propertyCount);
+void updateProperty(PropertyStore& store);
 
 /**
  * @brief Търси имот по неговия референтен номер.
  * @param refNumber Референтният номер на имота, който да се намери.
- * @param properties Масив от структури Property, в който да се търси.
- * @param propertyCount Броят на имотите в масива.
- * @return Индексът на имота в масива, ако е намерен, в противен случай -1.
+ * @param store Контейнерът с имоти, в който да се търси.
+ * @return Позицията на имота в контейнера, ако е намерен, в противен случай -1.
  *
  * Тази помощна функция е от решаващо значение за различни операции, които изискват локализиране на конкретен имот.
  */
-int getPropertyByRefNumber(int refNumber, const Property properties[], int propertyCount);
+int getPropertyByRefNumber(int refNumber, const PropertyStore& store);
 
 /**
  * @brief Актуализира референтния номер на имот.
- * @param properties Масив от структури Property.
- * @param propertyCount Броят на имотите в масива.
- * @param index Индексът на имота за актуализиране.
+ * @param store Контейнерът с имоти (необходим за проверка на уникалност).
+ * @param propertyToUpdate Референция към копието на имота, което се редактира.
  * @return true, ако референтният номер е успешно актуализиран, в противен случай false.
  *
  * Необходимо е специално обработване за refNumber, тъй като той трябва да остане уникален.
  */
-bool updateRefNumber(Property properties[], int propertyCount, int index);
+bool updateRefNumber(const PropertyStore& store, Property& propertyToUpdate);
 
 /**
  * @brief Актуализира текстово поле на имот с нов потребителски вход.
@@ -99,4 +97,14 @@ bool updateNumericField(T* fieldPtr, const char* fieldName) {
  */
 bool updateStatus(Property& propertyToUpdate);
 
+/**
+ * @brief Прилага нов статус към имот заедно с бизнес правилата за цената, без потребителско взаимодействие.
+ * @param propertyToUpdate Имотът, чийто статус се променя.
+ * @param newStatus Новият статус.
+ * @return true, ако статусът е променен; false, ако е идентичен със стария.
+ *
+ * При преминаване от НАЛИЧЕН към ЗАПАЗЕН цената се намалява с 20%.
+ */
+bool applyStatusChange(Property& propertyToUpdate, Status newStatus);
+
 #endif 
@@ -3,20 +3,23 @@
  * @brief Имплементация на функции за добавяне на нови имоти в системата за управление на недвижими имоти.
  *
  * Този файл предоставя конкретната имплементация за добавяне на единични или множество имоти,
- * включително валидиране на вход, проверки на капацитета и санитизация на данни, за да се гарантира целостта на данните.
+ * включително валидиране на вход и санитизация на данни, за да се гарантира целостта на данните.
  */
 
 #include <iostream>    
 #include <limits>      
 #include <cstring>     
+#include <cmath>       
 #include <type_traits> 
 #include <string>      
 #include <algorithm>   
 
 #include "add.h"       
 #include "structs.h"   
+#include "store.h"     
 #include "update.h"    
 #include "file.h"      
+#include "journal.h"   
 #include "colors.h"    
 #include "localization.h" 
 
@@ -43,29 +46,28 @@ void sanitizeString(char* str) {
     str[k] = '\0'; 
 }
 
+bool isValidMeasure(double value) {
+    return isfinite(value) && value >= 0.0;
+}
+
 /**
  * @brief Ръководи потребителя при добавяне на единичен нов имот в системата.
  *
  * Тази функция подканва потребителя за всички необходими детайли на имот,
  * валидира входа, проверява за уникални референтни номера и след това добавя
- * имота към масива `properties`. Тя обработва потенциални грешки като
- * дублиращи се референтни номера или достигане на максимален капацитет.
- * След успешно добавяне, тя задейства синхронизация на данните за възстановяване.
+ * имота в `store`. Контейнерът расте динамично, така че няма горна граница
+ * за броя на имотите. След успешно добавяне, тя задейства синхронизация на данните за възстановяване.
  *
- * @param properties Масив от структури `Property`, където ще бъде добавен новият имот.
- * @param propertyCount Референция към цяло число, представляващо текущия брой имоти.
+ * @param store Контейнерът с имоти, в който ще бъде добавен новият имот.
  */
-void addSingleProperty(Property properties[], int& propertyCount) {
-    
-    if (isCapacityReached(propertyCount)) return;
-
+void addSingleProperty(PropertyStore& store) {
     Property newProperty; 
 
     
     newProperty.refNumber = getValidNumericInput<int>((CYAN + getTranslatedString("PROMPT_REF_NUMBER") + RESET).c_str());
 
     
-    if (getPropertyByRefNumber(newProperty.refNumber, properties, propertyCount) != -1) {
+    if (getPropertyByRefNumber(newProperty.refNumber, store) != -1) {
         cout << RED << getTranslatedString("INVALID_DATA") << RESET << endl;
         cout << RED << getTranslatedString("ERROR_REF_NUMBER_EXISTS") << RESET << endl;
         cout << RED << getTranslatedString("ERROR_ADD_PROPERTY_FAILED") << RESET << endl;
@@ -86,68 +88,34 @@ void addSingleProperty(Property properties[], int& propertyCount) {
     getValidStringInput((CYAN + getTranslatedString("PROMPT_PROPERTY_EXPOSITION") + RESET).c_str(), newProperty.exposition, sizeof(newProperty.exposition));
 
     newProperty.status = AVAILABLE; 
-    properties[propertyCount] = newProperty; 
-    propertyCount++; 
+    addPropertyWithJournal(store, newProperty); 
 
     cout << endl;
     cout << GREEN << getTranslatedString("PROPERTY_ADDED_SUCCESS") << RESET << endl;
-    syncDataToRecoveryFiles(properties, propertyCount); 
 }
 
 /**
  * @brief Позволява на потребителя да добавя множество имоти в системата в една сесия.
  *
- * Тази функция първо подканва потребителя за броя имоти, които желае да добави.
- * След това проверява дали добавянето на толкова имоти би надхвърлило максималния капацитет на системата.
- * Ако капацитетът би бил надхвърлен, тя информира потребителя и коригира броя на имотите,
- * които да се добавят, за да се поберат в наличното пространство. Тя многократно извиква `addSingleProperty` за всеки
- * имот, който трябва да бъде добавен.
+ * Тази функция първо подканва потребителя за броя имоти, които желае да добави,
+ * заделя предварително място в контейнера и след това многократно извиква
+ * `addSingleProperty` за всеки имот, който трябва да бъде добавен.
  *
- * @param properties Масив от структури `Property`, където ще бъдат добавени новите имоти.
- * @param propertyCount Референция към цяло число, представляващо текущия брой имоти.
+ * @param store Контейнерът с имоти, в който ще бъдат добавени новите имоти.
  */
-void addMultipleProperties(Property properties[], int& propertyCount) {
+void addMultipleProperties(PropertyStore& store) {
     
     int n = getValidNumericInput<int>((CYAN + getTranslatedString("PROMPT_NUM_PROPERTIES_TO_ADD") + RESET).c_str());
 
-    
-    if (propertyCount + n > MAX_PROPERTIES) {
-        int availableSpace = MAX_PROPERTIES - propertyCount;
-        cout << RED << getTranslatedString("ERROR_ADD_EXCEEDS_MAX_PART1") << RESET << endl;
-        cout << YELLOW << getTranslatedString("ERROR_ADD_EXCEEDS_MAX_PART2") << " " << availableSpace << " " << getTranslatedString("ERROR_ADD_EXCEEDS_MAX_PART3") << RESET << endl;
-        n = availableSpace; 
-    }
-    
-    
-    if (n <= 0) {
-        isCapacityReached(propertyCount);
-        return;
-    }
+    if (n <= 0) return;
+
+    store.reserve(store.size() + n);
 
     
     for (int i = 0; i < n; i++) {
         cout << YELLOW << "\n--- " << getTranslatedString("PROMPT_ENTERING_PROPERTY") << " #" << (i + 1) << " " << getTranslatedString("PROMPT_OF") << " " << n << " ---" << RESET << endl;
-        addSingleProperty(properties, propertyCount); 
-    }
-}
-
-/**
- * @brief Проверява дали е достигнат максималният брой имоти (MAX_PROPERTIES).
- *
- * Тази функция сравнява текущия `propertyCount` с `MAX_PROPERTIES`.
- * Ако лимитът е достигнат, тя показва локализирани съобщения за грешка, указващи,
- * че не могат да бъдат добавени повече имоти.
- *
- * @param propertyCount Текущият брой имоти в системата.
- * @return `true`, ако капацитетът е достигнат; `false` в противен случай.
- */
-bool isCapacityReached(int propertyCount) {
-    if (propertyCount >= MAX_PROPERTIES) {
-        cout << RED << getTranslatedString("ERROR_ADD_NOT_POSSIBLE") << RESET << endl;
-        cout << RED << getTranslatedString("ERROR_MAX_CAPACITY_REACHED") << RESET << endl;
-        return true;
+        addSingleProperty(store); 
     }
-    return false;
 }
 
 /**
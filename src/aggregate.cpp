@@ -0,0 +1,387 @@
+/**
+ * @file aggregate.cpp
+ * @brief Имплементация на генератора на отчети с групиране, деклариран в `aggregate.h`.
+ *
+ * Изчислението минава през две стъпки. Първо за всеки имот се изчислява ключ на групата
+ * като число в смесена бройна система (по една цифра за всяко поле за групиране), колона
+ * по колона. Ако възможните комбинации са твърде много, съществуващите комбинации се
+ * преномерират последователно с хеш таблица. След това всички показатели се натрупват
+ * с едно обхождане чрез `groupByDenseKey`, по желание на няколко нишки. Медианата и
+ * персентилите се изчисляват със скици `QuantileSketch` при отделно обхождане за всяко
+ * числово поле, за да не се пазят скици в групите, когато не са нужни. Цената на кв.м.
+ * се изчислява предварително за цялата колона с векторизираното ядро `computePricePerSquareMetre`.
+ * Редовете на отчета се подреждат по ключове, изчислени веднъж за всеки ред: текстовите
+ * полета се заменят с ранга на стойността в азбучно подредения речник.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+
+#include "aggregate.h"
+#include "group.h"
+#include "kernels.h"
+#include "sketch.h"
+#include "sort.h"
+
+using namespace std;
+
+/**
+ * @brief Натрупано състояние на една група за всички числови полета.
+ *
+ * За стандартното отклонение се пазят сумите на отместените стойности `x - shift` и на
+ * квадратите им, където `shift` е една и съща стойност за всички групи на полето. Така
+ * дисперсията не губи точност, когато средното е много по-голямо от разсейването,
+ * а частичните състояния на нишките се сливат с обикновено събиране. `measured` е броят
+ * на определените стойности на всяко поле, с който се изчисляват средното и отклонението.
+ */
+struct GroupState {
+    int count;
+    int firstRow;
+    int measured[MEASURE_FIELD_COUNT];
+    double sum[MEASURE_FIELD_COUNT];
+    double shiftedSum[MEASURE_FIELD_COUNT];
+    double shiftedSquares[MEASURE_FIELD_COUNT];
+    double minimum[MEASURE_FIELD_COUNT];
+    double maximum[MEASURE_FIELD_COUNT];
+
+    /**
+     * Частичните състояния се сливат в реда на дяловете, затова `firstRow` на първото
+     * непразно състояние е най-малката позиция в групата.
+     */
+    GroupState& operator+=(const GroupState& other) {
+        if (other.count == 0) {
+            return *this;
+        }
+        if (count == 0) {
+            *this = other;
+            return *this;
+        }
+        count += other.count;
+        for (int field = 0; field < MEASURE_FIELD_COUNT; field++) {
+            if (other.measured[field] == 0) {
+                continue;
+            }
+            bool first = measured[field] == 0;
+            measured[field] += other.measured[field];
+            sum[field] += other.sum[field];
+            shiftedSum[field] += other.shiftedSum[field];
+            shiftedSquares[field] += other.shiftedSquares[field];
+            minimum[field] = first ? other.minimum[field] : min(minimum[field], other.minimum[field]);
+            maximum[field] = first ? other.maximum[field] : max(maximum[field], other.maximum[field]);
+        }
+        return *this;
+    }
+};
+
+/**
+ * @brief Връща стойността на числово поле за имота на позиция `row`.
+ * @param pricePerSqm Колоната с цени на кв.м., изчислена предварително, ако полето се използва.
+ * @return Стойността или NaN, ако тя не е определена (цена на кв.м. при площ, която не е положителна).
+ */
+static double measureValue(const PropertyStore& store, const vector<double>& pricePerSqm, MeasureField field, int row) {
+    switch (field) {
+        case MEASURE_PRICE: return store.prices()[row];
+        case MEASURE_TOTAL_AREA: return store.totalAreas()[row];
+        case MEASURE_FLOOR: return store.floors()[row];
+        case MEASURE_ROOMS: return store.rooms()[row];
+        case MEASURE_PRICE_PER_SQM: return pricePerSqm[row];
+        default: return store.statuses()[row] == SOLD ? 1.0 : 0.0;
+    }
+}
+
+/**
+ * @brief Връща стойността на поле за групиране за имота на позиция `row`.
+ */
+static int64_t groupValue(const PropertyStore& store, GroupField field, int row) {
+    switch (field) {
+        case GROUP_BROKER: return store.brokerIds()[row];
+        case GROUP_AREA: return store.areaIds()[row];
+        case GROUP_TYPE: return store.typeIds()[row];
+        case GROUP_EXPOSITION: return store.expositionIds()[row];
+        case GROUP_STATUS: return store.statuses()[row];
+        default: return store.rooms()[row];
+    }
+}
+
+/**
+ * @brief Връща дела на квантилния показател (0.5 за медианата) или 0 за останалите показатели.
+ */
+static double quantileFraction(Metric metric) {
+    switch (metric) {
+        case METRIC_MEDIAN: return 0.5;
+        case METRIC_P90: return 0.9;
+        case METRIC_P99: return 0.99;
+        default: return 0.0;
+    }
+}
+
+/**
+ * @brief Преномерира ключовете с последователни номера по реда на първата поява.
+ * @return Броят на различните ключове.
+ */
+static uint64_t compactKeys(vector<uint64_t>& keys) {
+    unordered_map<uint64_t, uint64_t> numbers;
+    numbers.reserve(1024);
+    for (uint64_t& key : keys) {
+        auto inserted = numbers.emplace(key, numbers.size());
+        key = inserted.first->second;
+    }
+    return numbers.size();
+}
+
+/**
+ * @brief Добавя полето `field` като следваща цифра на ключовете.
+ * @param groupCount Броят на възможните ключове досега; обновява се.
+ *
+ * Цифрата е отместването на стойността от най-малката стойност на полето. Когато
+ * произведението на броя стойности би надхвърлило 2^62, ключовете първо се преномерират.
+ */
+static void appendKeyDigit(const PropertyStore& store, GroupField field, vector<uint64_t>& keys, uint64_t& groupCount) {
+    int rowCount = store.size();
+    int64_t low = 0;
+    int64_t high = 0;
+    if (field == GROUP_STATUS) {
+        high = AVAILABLE;
+    } else if (field == GROUP_ROOMS) {
+        const int* rooms = store.rooms();
+        low = high = rooms[0];
+        for (int row = 1; row < rowCount; row++) {
+            low = min(low, (int64_t)rooms[row]);
+            high = max(high, (int64_t)rooms[row]);
+        }
+    } else {
+        const StringDictionary& dictionary = field == GROUP_BROKER ? store.brokers()
+            : field == GROUP_AREA ? store.areas() : field == GROUP_TYPE ? store.types() : store.expositions();
+        high = max(0, dictionary.size() - 1);
+    }
+    uint64_t base = (uint64_t)(high - low) + 1;
+
+    if (groupCount > ((uint64_t)1 << 62) / base) {
+        groupCount = compactKeys(keys);
+    }
+    for (int row = 0; row < rowCount; row++) {
+        keys[row] = keys[row] * base + (uint64_t)(groupValue(store, field, row) - low);
+    }
+    groupCount *= base;
+}
+
+/**
+ * @brief Подрежда редовете на отчета по полетата за групиране, като текстовите полета са по азбучен ред.
+ *
+ * Ключът за сортиране на всеки ред се изчислява веднъж - за текстово поле това е рангът
+ * на идентификатора в речника от `dictionaryRanks` - и се подреждат индексите на редовете,
+ * така че сравнението не създава низове и не мести редовете.
+ */
+static void sortReportRows(const PropertyStore& store, const GroupReportSpec& spec, vector<GroupReportRow>& rows) {
+    size_t fieldCount = spec.groupBy.size();
+    vector<int64_t> sortKeys(rows.size() * fieldCount);
+    for (size_t i = 0; i < fieldCount; i++) {
+        GroupField field = spec.groupBy[i];
+        vector<uint32_t> ranks;
+        if (field != GROUP_STATUS && field != GROUP_ROOMS) {
+            ranks = dictionaryRanks(field == GROUP_BROKER ? store.brokers() : field == GROUP_AREA ? store.areas()
+                                    : field == GROUP_TYPE ? store.types() : store.expositions());
+        }
+        for (size_t row = 0; row < rows.size(); row++) {
+            int64_t key = rows[row].keys[i];
+            sortKeys[row * fieldCount + i] = ranks.empty() ? key : ranks[key];
+        }
+    }
+
+    vector<uint32_t> order(rows.size());
+    iota(order.begin(), order.end(), 0u);
+    sort(order.begin(), order.end(), [&sortKeys, fieldCount](uint32_t a, uint32_t b) {
+        return lexicographical_compare(sortKeys.begin() + a * fieldCount, sortKeys.begin() + (a + 1) * fieldCount,
+                                       sortKeys.begin() + b * fieldCount, sortKeys.begin() + (b + 1) * fieldCount);
+    });
+
+    vector<GroupReportRow> sorted;
+    sorted.reserve(rows.size());
+    for (uint32_t index : order) {
+        sorted.push_back(move(rows[index]));
+    }
+    rows.swap(sorted);
+}
+
+vector<GroupReportRow> buildGroupReport(const PropertyStore& store, const GroupReportSpec& spec, int threadCount) {
+    vector<GroupReportRow> rows;
+    int rowCount = store.size();
+    if (rowCount == 0) {
+        return rows;
+    }
+
+    vector<uint64_t> wideKeys(rowCount, 0);
+    uint64_t groupCount = 1;
+    for (GroupField field : spec.groupBy) {
+        appendKeyDigit(store, field, wideKeys, groupCount);
+    }
+    if (groupCount > (uint64_t)DENSE_GROUP_LIMIT) {
+        groupCount = compactKeys(wideKeys);
+    }
+    vector<uint32_t> keys(wideKeys.begin(), wideKeys.end());
+    vector<uint64_t>().swap(wideKeys);
+
+    bool used[MEASURE_FIELD_COUNT] = {};
+    bool quantiles[MEASURE_FIELD_COUNT] = {};
+    for (const MetricSpec& metric : spec.metrics) {
+        if (quantileFraction(metric.metric) > 0.0) {
+            quantiles[metric.field] = true;
+        } else if (metric.metric != METRIC_COUNT) {
+            used[metric.field] = true;
+        }
+    }
+    vector<double> pricePerSqm;
+    if (used[MEASURE_PRICE_PER_SQM] || quantiles[MEASURE_PRICE_PER_SQM]) {
+        pricePerSqm.resize(rowCount);
+        computePricePerSquareMetre(store.prices(), store.totalAreas(), rowCount, pricePerSqm.data());
+    }
+
+    vector<MeasureField> fields;
+    double shift[MEASURE_FIELD_COUNT] = {};
+    for (int field = 0; field < MEASURE_FIELD_COUNT; field++) {
+        if (used[field]) {
+            fields.push_back((MeasureField)field);
+            for (int row = 0; row < rowCount; row++) {
+                double value = measureValue(store, pricePerSqm, (MeasureField)field, row);
+                if (value == value) {
+                    shift[field] = value;
+                    break;
+                }
+            }
+        }
+    }
+
+    vector<GroupState> groups = groupByDenseKey<GroupState>(keys.data(), rowCount, groupCount,
+        [&store, &pricePerSqm, &fields, &shift](GroupState& group, int row) {
+            if (group.count == 0) {
+                group.firstRow = row;
+            }
+            group.count++;
+            for (MeasureField field : fields) {
+                double value = measureValue(store, pricePerSqm, field, row);
+                if (value != value) {
+                    continue;
+                }
+                bool first = group.measured[field] == 0;
+                group.measured[field]++;
+                double shifted = value - shift[field];
+                group.sum[field] += value;
+                group.shiftedSum[field] += shifted;
+                group.shiftedSquares[field] += shifted * shifted;
+                group.minimum[field] = first ? value : min(group.minimum[field], value);
+                group.maximum[field] = first ? value : max(group.maximum[field], value);
+            }
+        }, threadCount);
+
+    vector<QuantileSketch> sketches[MEASURE_FIELD_COUNT];
+    for (int field = 0; field < MEASURE_FIELD_COUNT; field++) {
+        if (quantiles[field]) {
+            sketches[field] = groupByDenseKey<QuantileSketch>(keys.data(), rowCount, groupCount,
+                [&store, &pricePerSqm, field](QuantileSketch& sketch, int row) {
+                    double value = measureValue(store, pricePerSqm, (MeasureField)field, row);
+                    if (value == value) {
+                        sketch.add(value);
+                    }
+                }, threadCount);
+        }
+    }
+
+    for (size_t index = 0; index < groups.size(); index++) {
+        const GroupState& group = groups[index];
+        if (group.count == 0) {
+            continue;
+        }
+        GroupReportRow row;
+        for (GroupField field : spec.groupBy) {
+            row.keys.push_back(groupValue(store, field, group.firstRow));
+        }
+        for (const MetricSpec& metric : spec.metrics) {
+            int field = metric.field;
+            double value = 0.0;
+            switch (metric.metric) {
+                case METRIC_COUNT: value = group.count; break;
+                case METRIC_SUM: value = group.sum[field]; break;
+                case METRIC_AVERAGE: value = group.measured[field] > 0 ? group.sum[field] / group.measured[field] : 0.0; break;
+                case METRIC_MIN: value = group.minimum[field]; break;
+                case METRIC_MAX: value = group.maximum[field]; break;
+                case METRIC_MEDIAN:
+                case METRIC_P90:
+                case METRIC_P99: value = sketches[field][index].quantile(quantileFraction(metric.metric)); break;
+                default: {
+                    int measured = max(1, group.measured[field]);
+                    double mean = group.shiftedSum[field] / measured;
+                    value = sqrt(max(0.0, group.shiftedSquares[field] / measured - mean * mean));
+                    break;
+                }
+            }
+            row.values.push_back(value);
+        }
+        rows.push_back(row);
+    }
+
+    sortReportRows(store, spec, rows);
+    return rows;
+}
+
+string groupKeyText(const PropertyStore& store, GroupField field, int64_t key, bool localized) {
+    switch (field) {
+        case GROUP_BROKER: return store.brokers().lookup((uint32_t)key);
+        case GROUP_AREA: return store.areas().lookup((uint32_t)key);
+        case GROUP_TYPE: return store.types().lookup((uint32_t)key);
+        case GROUP_EXPOSITION: return store.expositions().lookup((uint32_t)key);
+        case GROUP_STATUS:
+            if (localized) return getStatusString((Status)key);
+            return key == SOLD ? "sold" : key == RESERVED ? "reserved" : "available";
+        default: return to_string(key);
+    }
+}
+
+bool parseGroupField(const string& name, GroupField& field) {
+    static const char* const NAMES[GROUP_FIELD_COUNT] = {"broker", "area", "type", "exposition", "status", "rooms"};
+    for (int i = 0; i < GROUP_FIELD_COUNT; i++) {
+        if (name == NAMES[i]) {
+            field = (GroupField)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static const char* const METRIC_NAMES[METRIC_COUNT_ALL] = {"count", "sum", "avg", "min", "max", "stddev", "median", "p90", "p99"};
+static const char* const MEASURE_NAMES[MEASURE_FIELD_COUNT] = {"price", "totalArea", "floor", "rooms", "sold", "pricePerSqm"};
+
+bool parseMetricSpec(const string& text, MetricSpec& spec) {
+    size_t colon = text.find(':');
+    string metricName = text.substr(0, colon);
+    spec.field = MEASURE_PRICE;
+
+    int metric = 0;
+    while (metric < METRIC_COUNT_ALL && metricName != METRIC_NAMES[metric]) {
+        metric++;
+    }
+    if (metric == METRIC_COUNT_ALL) return false;
+    spec.metric = (Metric)metric;
+    if (spec.metric == METRIC_COUNT) {
+        return colon == string::npos;
+    }
+    if (colon == string::npos) return false;
+
+    string fieldName = text.substr(colon + 1);
+    for (int field = 0; field < MEASURE_FIELD_COUNT; field++) {
+        if (fieldName == MEASURE_NAMES[field]) {
+            spec.field = (MeasureField)field;
+            return true;
+        }
+    }
+    return false;
+}
+
+string metricSpecName(const MetricSpec& spec) {
+    if (spec.metric == METRIC_COUNT) {
+        return METRIC_NAMES[METRIC_COUNT];
+    }
+    return string(METRIC_NAMES[spec.metric]) + "(" + MEASURE_NAMES[spec.field] + ")";
+}
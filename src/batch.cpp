@@ -0,0 +1,690 @@
+/**
+ * @file batch.cpp
+ * @brief Имплементация на пакетния режим, деклариран в `batch.h`.
+ *
+ * Всяка команда се обработва от отделна функция, която при успех отпечатва резултата си
+ * и връща `NULL`, а при неуспех връща кода на грешката. Изходът се записва чрез `stdio`
+ * и се буферира изцяло, когато стандартният изход е пренасочен към файл или канал.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <charconv>
+#include <cmath>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "batch.h"
+#include "structs.h"
+#include "store.h"
+#include "file.h"
+#include "journal.h"
+#include "parse.h"
+#include "import.h"
+#include "search.h"
+#include "query.h"
+#include "reports.h"
+#include "aggregate.h"
+#include "sort.h"
+#include "update.h"
+#include "add.h"
+
+using namespace std;
+
+/**
+ * @brief Отделя следващата дума от `rest`, пропускайки интервалите пред нея.
+ */
+static string_view nextToken(string_view& rest) {
+    size_t start = rest.find_first_not_of(" \t");
+    if (start == string_view::npos) {
+        rest = string_view();
+        return string_view();
+    }
+    size_t end = rest.find_first_of(" \t", start);
+    if (end == string_view::npos) end = rest.size();
+    string_view token = rest.substr(start, end - start);
+    rest.remove_prefix(end);
+    return token;
+}
+
+/**
+ * @brief Премахва интервалите в началото и края на текст.
+ */
+static string_view trim(string_view text) {
+    size_t start = text.find_first_not_of(" \t\r");
+    if (start == string_view::npos) return string_view();
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(start, end - start + 1);
+}
+
+/**
+ * @brief Разчита целия текст като число.
+ */
+template <typename T>
+static bool parseValue(string_view text, T& value) {
+    const char* end = text.data() + text.size();
+    from_chars_result result = from_chars(text.data(), end, value);
+    return !text.empty() && result.ec == errc() && result.ptr == end;
+}
+
+/**
+ * @brief Копира текстова стойност в буфер на `Property` по правилата на ръчното въвеждане.
+ */
+static bool copyTextValue(string_view text, char* destination, size_t size) {
+    size_t length = min(text.size(), size - 1);
+    memcpy(destination, text.data(), length);
+    destination[length] = '\0';
+    sanitizeString(destination);
+    return destination[0] != '\0';
+}
+
+/**
+ * @brief Санитизира на място текстово поле на `Property` по правилата на ръчното въвеждане.
+ */
+static bool sanitizeTextValue(char* text) {
+    sanitizeString(text);
+    return text[0] != '\0';
+}
+
+static void printRow(const PropertyView& property) {
+    fputs("ROW ", stdout);
+    writeSyncRecord(stdout, property);
+}
+
+static const char* commandAdd(string_view rest, PropertyStore& store) {
+    string_view record = trim(rest);
+    Property property;
+    if (!parseSyncFields(record.data(), record.data() + record.size(), property)) {
+        return "syntax";
+    }
+    if (!isValidMeasure(property.price) || !isValidMeasure(property.totalArea) ||
+        !sanitizeTextValue(property.broker) || !sanitizeTextValue(property.type) ||
+        !sanitizeTextValue(property.area) || !sanitizeTextValue(property.exposition)) {
+        return "bad_value";
+    }
+    if (store.findByRefNumber(property.refNumber) != -1) {
+        return "duplicate_ref";
+    }
+    if (!addPropertyWithJournal(store, property)) return "bad_value";
+    printf("OK add ref=%d\n", property.refNumber);
+    return NULL;
+}
+
+/**
+ * Прилагат се същите правила като в `updateProperty`: продаден имот не може да бъде
+ * променян, новият референтен номер трябва да е уникален, а смяната на статуса
+ * минава през `applyStatusChange`.
+ */
+static const char* commandUpdate(string_view rest, PropertyStore& store) {
+    int refNumber;
+    if (!parseValue(nextToken(rest), refNumber)) return "syntax";
+    string_view field = nextToken(rest);
+    string_view value = trim(rest);
+    if (field.empty() || value.empty()) return "syntax";
+
+    int slot = store.findByRefNumber(refNumber);
+    if (slot == -1) return "not_found";
+
+    Property edited = store.get(slot);
+    if (edited.status == SOLD) return "sold_readonly";
+
+    bool valid = true;
+    if (field == "ref") {
+        int newRefNumber;
+        valid = parseValue(value, newRefNumber);
+        if (valid && newRefNumber != refNumber && store.findByRefNumber(newRefNumber) != -1) return "duplicate_ref";
+        if (valid) edited.refNumber = newRefNumber;
+    } else if (field == "broker") {
+        valid = copyTextValue(value, edited.broker, sizeof(edited.broker));
+    } else if (field == "type") {
+        valid = copyTextValue(value, edited.type, sizeof(edited.type));
+    } else if (field == "area") {
+        valid = copyTextValue(value, edited.area, sizeof(edited.area));
+    } else if (field == "exposition") {
+        valid = copyTextValue(value, edited.exposition, sizeof(edited.exposition));
+    } else if (field == "price") {
+        valid = parseValue(value, edited.price) && isValidMeasure(edited.price);
+    } else if (field == "totalArea") {
+        valid = parseValue(value, edited.totalArea) && isValidMeasure(edited.totalArea);
+    } else if (field == "rooms") {
+        valid = parseValue(value, edited.rooms);
+    } else if (field == "floor") {
+        valid = parseValue(value, edited.floor);
+    } else if (field == "status") {
+        int statusInt = -1;
+        if (value == "sold") statusInt = SOLD;
+        else if (value == "reserved") statusInt = RESERVED;
+        else if (value == "available") statusInt = AVAILABLE;
+        else if (!parseValue(value, statusInt)) statusInt = -1;
+        valid = statusInt >= SOLD && statusInt <= AVAILABLE;
+        if (valid) applyStatusChange(edited, (Status)statusInt);
+    } else {
+        return "syntax";
+    }
+    if (!valid) return "bad_value";
+
+    if (!updatePropertyWithJournal(store, slot, edited)) return "bad_value";
+    printf("OK update ref=%d\n", edited.refNumber);
+    return NULL;
+}
+
+static const char* commandDelete(string_view rest, PropertyStore& store) {
+    int refNumber;
+    if (!parseValue(nextToken(rest), refNumber)) return "syntax";
+
+    int slot = store.findByRefNumber(refNumber);
+    if (slot == -1) return "not_found";
+
+    removePropertyWithJournal(store, slot);
+    printf("OK delete ref=%d\n", refNumber);
+    return NULL;
+}
+
+static const char* commandGet(string_view rest, const PropertyStore& store) {
+    int refNumber;
+    if (!parseValue(nextToken(rest), refNumber)) return "syntax";
+
+    int slot = store.findByRefNumber(refNumber);
+    if (slot == -1) return "not_found";
+
+    printRow(store.view(slot));
+    printf("OK get ref=%d\n", refNumber);
+    return NULL;
+}
+
+/**
+ * @brief Отпечатва имотите от дадени позиции в реда на позициите.
+ */
+static void printRows(const PropertyStore& store, SlotSpan slots) {
+    for (uint32_t slot : slots) {
+        printRow(store.view(slot));
+    }
+}
+
+/**
+ * @brief Разчита граница на интервал; `*` означава липса на граница (безкрайност със знак `unbounded`).
+ */
+static bool parseBound(string_view text, double unbounded, double& value) {
+    if (text == "*") {
+        value = unbounded;
+        return true;
+    }
+    return parseValue(text, value);
+}
+
+/**
+ * @brief Разчита условията на `search range`: тройки `<поле> <мин> <макс>`.
+ */
+static bool parseRangeConditions(string_view rest, vector<RangeCondition>& conditions) {
+    const double infinity = numeric_limits<double>::infinity();
+    while (true) {
+        string_view field = nextToken(rest);
+        if (field.empty()) {
+            return !conditions.empty();
+        }
+        RangeCondition condition;
+        if (field == "price") condition.field = RANGE_PRICE;
+        else if (field == "totalArea") condition.field = RANGE_TOTAL_AREA;
+        else if (field == "floor") condition.field = RANGE_FLOOR;
+        else if (field == "rooms") condition.field = RANGE_ROOMS;
+        else return false;
+        if (!parseBound(nextToken(rest), -infinity, condition.low) || !parseBound(nextToken(rest), infinity, condition.high)) {
+            return false;
+        }
+        conditions.push_back(condition);
+    }
+}
+
+/**
+ * @brief Отделя следващата лексема на израза на `search where`.
+ *
+ * Лексемите са скоби, операторите `=`, `<`, `<=`, `>`, `>=`, текст в двойни кавички
+ * (без кавичките) или дума до интервал, скоба, оператор или кавичка. При незатворени
+ * кавички `valid` става `false`.
+ */
+static string_view nextWhereToken(string_view& rest, bool& valid) {
+    size_t start = rest.find_first_not_of(" \t");
+    if (start == string_view::npos) {
+        rest = string_view();
+        return string_view();
+    }
+    rest.remove_prefix(start);
+
+    size_t length = 1;
+    if (rest[0] == '"') {
+        size_t end = rest.find('"', 1);
+        if (end == string_view::npos) {
+            valid = false;
+            rest = string_view();
+            return string_view();
+        }
+        string_view token = rest.substr(1, end - 1);
+        rest.remove_prefix(end + 1);
+        return token;
+    }
+    if ((rest[0] == '<' || rest[0] == '>') && rest.size() > 1 && rest[1] == '=') {
+        length = 2;
+    } else if (rest[0] != '(' && rest[0] != ')' && rest[0] != '<' && rest[0] != '>' && rest[0] != '=') {
+        length = rest.find_first_of(" \t()<>=\"");
+        if (length == string_view::npos) length = rest.size();
+    }
+    string_view token = rest.substr(0, length);
+    rest.remove_prefix(length);
+    return token;
+}
+
+/**
+ * @brief Рекурсивен разборчик на израза на `search where`.
+ *
+ * Граматика (`and` има по-висок приоритет от `or`):
+ * `израз = терм { or терм }`, `терм = множител { and множител }`,
+ * `множител = ( израз ) | <поле> <оператор> <стойност>`.
+ */
+struct WhereParser {
+    string_view rest;
+    string_view token;
+    bool valid;
+
+    explicit WhereParser(string_view text) : rest(text), valid(true) {
+        advance();
+    }
+
+    void advance() {
+        token = nextWhereToken(rest, valid);
+    }
+
+    bool parseExpression(Query& query) {
+        if (!parseTerm(query)) return false;
+        while (token == "or") {
+            advance();
+            Query right = Query::all();
+            if (!parseTerm(right)) return false;
+            query = query || right;
+        }
+        return true;
+    }
+
+    bool parseTerm(Query& query) {
+        if (!parseFactor(query)) return false;
+        while (token == "and") {
+            advance();
+            Query right = Query::all();
+            if (!parseFactor(right)) return false;
+            query = query && right;
+        }
+        return true;
+    }
+
+    bool parseFactor(Query& query) {
+        if (token == "(") {
+            advance();
+            if (!parseExpression(query) || token != ")") return false;
+            advance();
+            return true;
+        }
+        return parseCondition(query);
+    }
+
+    /**
+     * Текстовите полета и статусът допускат само `=`; строгите неравенства при числовите
+     * полета се превеждат в затворен интервал чрез съседното представимо число.
+     */
+    bool parseCondition(Query& query) {
+        string_view field = token;
+        advance();
+        string_view op = token;
+        advance();
+        string_view value = token;
+        if (!valid || field.empty() || value.empty()) return false;
+        if (op != "=" && op != "<" && op != "<=" && op != ">" && op != ">=") return false;
+        advance();
+
+        if (field == "broker" || field == "type" || field == "area" || field == "exposition" || field == "status") {
+            if (op != "=") return false;
+            string text(value);
+            if (field == "broker") query = Query::broker(text);
+            else if (field == "type") query = Query::type(text);
+            else if (field == "area") query = Query::area(text);
+            else if (field == "exposition") query = Query::exposition(text);
+            else if (value == "sold") query = Query::status(SOLD);
+            else if (value == "reserved") query = Query::status(RESERVED);
+            else if (value == "available") query = Query::status(AVAILABLE);
+            else return false;
+            return true;
+        }
+
+        double number;
+        if (!parseValue(value, number)) return false;
+        const double infinity = numeric_limits<double>::infinity();
+        double low = -infinity;
+        double high = infinity;
+        if (op == "=") { low = number; high = number; }
+        else if (op == "<") high = nextafter(number, -infinity);
+        else if (op == "<=") high = number;
+        else if (op == ">") low = nextafter(number, infinity);
+        else low = number;
+
+        if (field == "price") query = Query::price(low, high);
+        else if (field == "totalArea") query = Query::totalArea(low, high);
+        else if (field == "floor") query = Query::floor(low, high);
+        else if (field == "rooms") query = Query::rooms(low, high);
+        else return false;
+        return true;
+    }
+};
+
+static const char* commandSearch(string_view rest, const PropertyStore& store) {
+    string_view criterion = nextToken(rest);
+    string_view value = trim(rest);
+    if (value.empty()) return "syntax";
+
+    vector<uint32_t> slots;
+    if (criterion == "range") {
+        vector<RangeCondition> conditions;
+        if (!parseRangeConditions(value, conditions)) return "syntax";
+        for (const RangeCondition& condition : conditions) {
+            if (condition.low > condition.high) return "bad_value";
+        }
+        slots = findSlotsInRanges(store, conditions);
+    } else if (criterion == "where") {
+        WhereParser parser(value);
+        Query query = Query::all();
+        if (!parser.parseExpression(query) || !parser.valid || !parser.token.empty()) return "syntax";
+        slots = query.findSlotsByPrice(store, true);
+    } else if (criterion == "broker") {
+        slots = findSlotsByBroker(store, string(value).c_str(), true);
+    } else if (criterion == "rooms") {
+        int roomsCount;
+        if (!parseValue(value, roomsCount)) return "syntax";
+        slots = findSlotsByRooms(store, roomsCount, false);
+    } else {
+        return "syntax";
+    }
+
+    printRows(store, slots);
+    printf("OK search count=%d\n", (int)slots.size());
+    return NULL;
+}
+
+/**
+ * @brief Разпознава името на поле за сортиране (същите имена като в командата `update`).
+ */
+static bool parseSortField(string_view name, SortField& field) {
+    static const char* const NAMES[SORT_FIELD_COUNT] = {
+        "ref", "broker", "type", "area", "exposition", "price", "totalArea", "rooms", "floor", "status"
+    };
+    for (int i = 0; i < SORT_FIELD_COUNT; i++) {
+        if (name == NAMES[i]) {
+            field = (SortField)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Сортирането само по цена минава през `sortByPrice`, който избира поразрядно сортиране
+ * за големи каталози; то е стабилно, затова `stable` не променя резултата.
+ */
+static const char* commandSort(string_view rest, PropertyStore& store) {
+    vector<SortCriterion> criteria;
+    bool stable = false;
+    for (string_view token = nextToken(rest); !token.empty(); token = nextToken(rest)) {
+        if (token == "stable") {
+            stable = true;
+            continue;
+        }
+        SortCriterion criterion;
+        string_view order = nextToken(rest);
+        if (!parseSortField(token, criterion.field) || (order != "asc" && order != "desc")) return "syntax";
+        criterion.ascending = order == "asc";
+        criteria.push_back(criterion);
+    }
+    if (criteria.empty() || (int)criteria.size() > MAX_SORT_CRITERIA) return "syntax";
+
+    if (criteria.size() == 1 && criteria[0].field == SORT_FIELD_PRICE) {
+        store.sortByPrice(criteria[0].ascending);
+    } else {
+        store.sortByFields(criteria, stable);
+    }
+    syncDataToRecoveryFiles(store);
+    printf("OK sort count=%d\n", store.size());
+    return NULL;
+}
+
+/**
+ * @brief Разчита описанието на `report group`: полета за групиране, разделени със запетая
+ * (или `-` без групиране), и показатели, разделени със запетая.
+ */
+static bool parseGroupReportSpec(string_view fields, string_view metrics, GroupReportSpec& spec) {
+    if (fields.empty() || metrics.empty()) return false;
+    if (fields != "-") {
+        while (!fields.empty()) {
+            size_t comma = min(fields.find(','), fields.size());
+            GroupField field;
+            if (!parseGroupField(string(fields.substr(0, comma)), field)) return false;
+            spec.groupBy.push_back(field);
+            fields.remove_prefix(min(comma + 1, fields.size()));
+        }
+    }
+    while (!metrics.empty()) {
+        size_t comma = min(metrics.find(','), metrics.size());
+        MetricSpec metric;
+        if (!parseMetricSpec(string(metrics.substr(0, comma)), metric)) return false;
+        spec.metrics.push_back(metric);
+        metrics.remove_prefix(min(comma + 1, metrics.size()));
+    }
+    return true;
+}
+
+static const char* commandReport(string_view rest, const PropertyStore& store) {
+    string_view kind = nextToken(rest);
+    string area(trim(rest));
+
+    if (kind == "expensive") {
+        if (area.empty()) return "syntax";
+        int slot = findMostExpensiveInArea(store, area.c_str());
+        if (slot == -1) return "not_found";
+        printRow(store.view(slot));
+        printf("OK report\n");
+    } else if (kind == "average") {
+        if (area.empty()) return "syntax";
+        double totalPrice;
+        int count = sumPricesInArea(store, area.c_str(), totalPrice);
+        if (count == 0) return "not_found";
+        printf("OK report count=%d total=%.2f average=%.2f median=%.2f\n", count, totalPrice, totalPrice / count,
+               medianPriceInArea(store, area.c_str()));
+    } else if (kind == "top-expensive" || kind == "top-largest" || kind == "top-cheapest-sqm") {
+        string_view arguments = trim(rest);
+        size_t count;
+        if (!parseValue(nextToken(arguments), count) || count == 0) return "syntax";
+        string topArea(trim(arguments));
+        vector<uint32_t> slots;
+        if (kind == "top-expensive") {
+            if (topArea.empty()) return "syntax";
+            slots = findTopExpensiveInArea(store, topArea.c_str(), count);
+        } else if (kind == "top-largest") {
+            slots = findLargestProperties(store, count);
+        } else {
+            slots = findCheapestPerSquareMetre(store, count);
+        }
+        printRows(store, slots);
+        printf("OK report count=%d\n", (int)slots.size());
+    } else if (kind == "group") {
+        string_view arguments = trim(rest);
+        GroupReportSpec spec;
+        string_view fields = nextToken(arguments);
+        string_view metrics = nextToken(arguments);
+        if (!parseGroupReportSpec(fields, metrics, spec) || !trim(arguments).empty()) return "syntax";
+        vector<GroupReportRow> rows = buildGroupReport(store, spec);
+        for (const GroupReportRow& row : rows) {
+            fputs("GROUP ", stdout);
+            for (size_t i = 0; i < row.keys.size(); i++) {
+                printf("%s|", groupKeyText(store, spec.groupBy[i], row.keys[i], false).c_str());
+            }
+            for (size_t i = 0; i < row.values.size(); i++) {
+                if (spec.metrics[i].metric == METRIC_COUNT) {
+                    printf(i + 1 < row.values.size() ? "%.0f|" : "%.0f\n", row.values[i]);
+                } else {
+                    printf(i + 1 < row.values.size() ? "%.2f|" : "%.2f\n", row.values[i]);
+                }
+            }
+        }
+        printf("OK report count=%d\n", (int)rows.size());
+    } else if (kind == "sqm-outliers") {
+        string_view arguments = trim(rest);
+        double sigmas;
+        if (!parseValue(nextToken(arguments), sigmas) || !(sigmas > 0.0) || !trim(arguments).empty()) return "syntax";
+        vector<PriceOutlier> outliers = findPricePerSquareMetreOutliers(store, sigmas);
+        for (const PriceOutlier& outlier : outliers) {
+            PropertyView property = store.view(outlier.slot);
+            printf("OUTLIER %d|%s|%.2f|%.2f\n", property.refNumber, property.area, outlier.pricePerSqm, outlier.deviation);
+        }
+        printf("OK report count=%d\n", (int)outliers.size());
+    } else if (kind == "all-areas") {
+        string_view arguments = trim(rest);
+        string_view orderName = nextToken(arguments);
+        string path(trim(arguments));
+        AreaSortOrder order = AREA_SORT_BY_NAME;
+        if (!orderName.empty() && !parseAreaSortOrder(string(orderName).c_str(), order)) return "syntax";
+        vector<AreaSummary> summaries = computeAreaSummaries(store);
+        sortAreaSummaries(store, summaries, order);
+        FILE* file = path.empty() ? stdout : fopen(path.c_str(), "w");
+        if (file == NULL) return "io";
+        for (const AreaSummary& area : summaries) {
+            PropertyView mostExpensive = store.view(area.mostExpensiveSlot);
+            fprintf(file, "AREA %s|%d|%.2f|%.2f|%.2f|%d\n", store.areas().lookup(area.areaId), area.count, area.totalPrice,
+                    area.totalPrice / area.count, mostExpensive.price, mostExpensive.refNumber);
+        }
+        bool written = !ferror(file);
+        if (file != stdout && fclose(file) != 0) written = false;
+        if (!written) return "io";
+        printf("OK report count=%d\n", (int)summaries.size());
+    } else if (kind == "sold-by-broker") {
+        vector<BrokerSales> salesPerBroker = computeSalesPerBroker(store);
+        for (const BrokerSales& sales : salesPerBroker) {
+            printf("BROKER %s|%d|%d|%.2f\n", store.brokers().lookup(sales.brokerId), sales.total, sales.sold,
+                   sales.total > 0 ? 100.0 * sales.sold / sales.total : 0.0);
+        }
+        printf("OK report count=%d\n", (int)salesPerBroker.size());
+    } else {
+        return "syntax";
+    }
+    return NULL;
+}
+
+static const char* commandImport(string_view rest, PropertyStore& store) {
+    string path(trim(rest));
+    if (path.empty()) return "syntax";
+
+    ImportResult result = importProperties(path.c_str(), store);
+    if (!result.opened) return "io";
+    if (result.imported > 0) {
+        syncDataToRecoveryFiles(store);
+    }
+    printf("OK import rows=%d imported=%d rejected=%d seconds=%.3f\n", result.rowsRead, result.imported, result.rejected, result.seconds);
+    return NULL;
+}
+
+static const char* commandSave(string_view rest, const PropertyStore& store) {
+    string path(trim(rest));
+    if (path.empty()) {
+        if (!syncDataToRecoveryFiles(store)) return "io";
+    } else if (!writeBinaryFile(path.c_str(), store)) {
+        return "io";
+    }
+    printf("OK save count=%d\n", store.size());
+    return NULL;
+}
+
+/**
+ * @brief Изпълнява една команда.
+ * @return `NULL` при успех или кода на грешката.
+ */
+static const char* executeCommand(string_view line, PropertyStore& store, bool& mutated) {
+    string_view rest = line;
+    string_view command = nextToken(rest);
+
+    if (command == "add") { mutated = true; return commandAdd(rest, store); }
+    if (command == "update") { mutated = true; return commandUpdate(rest, store); }
+    if (command == "delete") { mutated = true; return commandDelete(rest, store); }
+    if (command == "clear") {
+        mutated = true;
+        clearPropertiesWithJournal(store);
+        printf("OK clear\n");
+        return NULL;
+    }
+    if (command == "get") return commandGet(rest, store);
+    if (command == "count") { printf("OK count=%d\n", store.size()); return NULL; }
+    if (command == "list") {
+        for (int i = 0; i < store.size(); i++) {
+            printRow(store.view(i));
+        }
+        printf("OK list count=%d\n", store.size());
+        return NULL;
+    }
+    if (command == "search") return commandSearch(rest, store);
+    if (command == "sort") return commandSort(rest, store);
+    if (command == "report") return commandReport(rest, store);
+    if (command == "import") return commandImport(rest, store);
+    if (command == "save") return commandSave(rest, store);
+    if (command == "verify") {
+        if (!store.verifyAreaAggregates()) return "mismatch";
+        printf("OK verify\n");
+        return NULL;
+    }
+    return "unknown_command";
+}
+
+int runBatchScript(const char* scriptPath) {
+    ifstream scriptFile;
+    bool fromStdin = strcmp(scriptPath, "-") == 0;
+    if (!fromStdin) {
+        scriptFile.open(scriptPath);
+        if (!scriptFile.is_open()) {
+            fprintf(stderr, "ERR 0 io cannot open script '%s'\n", scriptPath);
+            return 2;
+        }
+    }
+    istream& script = fromStdin ? cin : scriptFile;
+
+    PropertyStore store;
+    readRecoveryFiles(store);
+
+    auto startTime = chrono::steady_clock::now();
+    int commands = 0;
+    int errors = 0;
+    int lineNumber = 0;
+    bool mutated = false;
+    string line;
+    while (getline(script, line)) {
+        lineNumber++;
+        string_view command = trim(line);
+        if (command.empty() || command[0] == '#') {
+            continue;
+        }
+
+        commands++;
+        const char* error = executeCommand(command, store, mutated);
+        if (error != NULL) {
+            errors++;
+            printf("ERR %d %s\n", lineNumber, error);
+        }
+    }
+
+    if (mutated) {
+        syncDataToRecoveryFiles(store);
+    }
+    closeJournal();
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+    printf("DONE commands=%d errors=%d seconds=%.3f ops_per_sec=%.0f\n", commands, errors, seconds,
+           seconds > 0 ? commands / seconds : 0.0);
+    fflush(stdout);
+    return errors == 0 ? 0 : 1;
+}
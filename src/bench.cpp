@@ -0,0 +1,449 @@
+/**
+ * @file bench.cpp
+ * @brief Имплементация на сравнителните тестове, декларирани в `bench.h`.
+ *
+ * Всеки тест е функция, която за даден брой записи генерира данни, измерва вариантите
+ * и проверява, че те дават еднакъв резултат. Тестовете са изброени в таблицата `BENCHMARKS`.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "sort.h"
+#include "group.h"
+#include "kernels.h"
+#include "store.h"
+#include "structs.h"
+
+using namespace std;
+
+/**
+ * @brief Генерира `count` цени с по два знака след десетичната запетая, включително повтарящи се.
+ */
+static vector<double> generatePrices(size_t count) {
+    mt19937_64 generator(20240601);
+    uniform_int_distribution<int64_t> cents(1000000, 100000000);
+    vector<double> prices(count);
+    for (double& price : prices) {
+        price = cents(generator) / 100.0;
+    }
+    return prices;
+}
+
+/**
+ * @brief Измерва в милисекунди най-бързото от `repeats` изпълнения на `work`.
+ *
+ * Преди всяко изпълнение се извиква `prepare`, което не влиза в измереното време.
+ */
+template <typename Prepare, typename Work>
+static double measureMilliseconds(int repeats, Prepare prepare, Work work) {
+    double best = 0;
+    for (int i = 0; i < repeats; i++) {
+        prepare();
+        auto startTime = chrono::steady_clock::now();
+        work();
+        double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - startTime).count();
+        if (i == 0 || elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+/**
+ * Сравнява последователното сортиране на позиции по цена чрез сравнения с `parallelSort`. Паралелният вариант
+ * използва поне две нишки, за да бъде измерен и на машини с едно ядро.
+ */
+static bool benchmarkSort(size_t count) {
+    vector<double> prices = generatePrices(count);
+    vector<uint32_t> serial(count);
+    vector<uint32_t> parallel(count);
+    int threadCount = max(2, (int)thread::hardware_concurrency());
+    int repeats = count <= 1000000 ? 3 : 1;
+
+    double serialTime = measureMilliseconds(repeats, [&]() { iota(serial.begin(), serial.end(), 0u); },
+        [&]() { sortSlotsByKey(serial.data(), serial.data() + count, prices.data(), true, 1, SORT_METHOD_COMPARISON); });
+    double parallelTime = measureMilliseconds(repeats, [&]() { iota(parallel.begin(), parallel.end(), 0u); },
+        [&]() { sortSlotsByKey(parallel.data(), parallel.data() + count, prices.data(), true, threadCount, SORT_METHOD_COMPARISON); });
+
+    bool matches = serial == parallel;
+    printf("BENCH sort n=%zu serial_ms=%.1f parallel_ms=%.1f threads=%d speedup=%.2f%s\n", count, serialTime, parallelTime,
+           threadCount, parallelTime > 0 ? serialTime / parallelTime : 0.0, matches ? "" : " MISMATCH");
+    return matches;
+}
+
+/**
+ * @brief Измерва сортирането на позиции по една колона чрез сравнения и поразрядно и отпечатва реда с резултата.
+ */
+template <typename K>
+static bool benchmarkRadixColumn(const char* keyName, const vector<K>& keys, bool sortAscending) {
+    size_t count = keys.size();
+    vector<uint32_t> comparison(count);
+    vector<uint32_t> radix(count);
+    int repeats = count <= 1000000 ? 3 : 1;
+
+    double comparisonTime = measureMilliseconds(repeats, [&]() { iota(comparison.begin(), comparison.end(), 0u); },
+        [&]() { sortSlotsByKey(comparison.data(), comparison.data() + count, keys.data(), sortAscending, 1, SORT_METHOD_COMPARISON); });
+    double radixTime = measureMilliseconds(repeats, [&]() { iota(radix.begin(), radix.end(), 0u); },
+        [&]() { sortSlotsByKey(radix.data(), radix.data() + count, keys.data(), sortAscending, 1, SORT_METHOD_RADIX); });
+
+    bool matches = comparison == radix;
+    printf("BENCH radix n=%zu key=%s order=%s comparison_ms=%.1f radix_ms=%.1f speedup=%.2f%s\n", count, keyName,
+           sortAscending ? "asc" : "desc", comparisonTime, radixTime, radixTime > 0 ? comparisonTime / radixTime : 0.0,
+           matches ? "" : " MISMATCH");
+    return matches;
+}
+
+/**
+ * Сравнява сортирането чрез сравнения с поразрядното за цена (`double`, възходящо и низходящо)
+ * и за брой стаи (`int` с малък обхват, при който повечето проходи се пропускат).
+ */
+static bool benchmarkRadix(size_t count) {
+    vector<double> prices = generatePrices(count);
+    vector<int> rooms(count);
+    mt19937 generator(20240602);
+    uniform_int_distribution<int> roomsDistribution(1, 8);
+    for (int& value : rooms) {
+        value = roomsDistribution(generator);
+    }
+
+    bool matches = benchmarkRadixColumn("price", prices, true);
+    matches = benchmarkRadixColumn("price", prices, false) && matches;
+    matches = benchmarkRadixColumn("rooms", rooms, false) && matches;
+    return matches;
+}
+
+/**
+ * @brief Брой на всички и на продадените имоти в една група.
+ */
+struct SalesCounts {
+    int total;
+    int sold;
+
+    SalesCounts& operator+=(const SalesCounts& other) {
+        total += other.total;
+        sold += other.sold;
+        return *this;
+    }
+
+    bool operator==(const SalesCounts& other) const {
+        return total == other.total && sold == other.sold;
+    }
+};
+
+/**
+ * Сравнява статистиката по брокери чрез `std::map` с низове (по един низ за всеки имот)
+ * с групирането по идентификатор чрез `groupByDenseKey` последователно и на поне две нишки.
+ */
+static bool benchmarkGroup(size_t count) {
+    const int brokerCount = 500;
+    vector<string> brokerNames(brokerCount);
+    for (int id = 0; id < brokerCount; id++) {
+        brokerNames[id] = "Broker " + to_string(id);
+    }
+    mt19937 generator(20240603);
+    uniform_int_distribution<uint32_t> brokerDistribution(0, brokerCount - 1);
+    uniform_int_distribution<int> statusDistribution(SOLD, AVAILABLE);
+    vector<uint32_t> brokerIds(count);
+    vector<unsigned char> statuses(count);
+    for (size_t i = 0; i < count; i++) {
+        brokerIds[i] = brokerDistribution(generator);
+        statuses[i] = (unsigned char)statusDistribution(generator);
+    }
+
+    int rowCount = (int)count;
+    int threadCount = max(2, (int)thread::hardware_concurrency());
+    int repeats = count <= 1000000 ? 3 : 1;
+    auto accumulate = [&statuses](SalesCounts& counts, int row) {
+        counts.total++;
+        counts.sold += (statuses[row] == SOLD);
+    };
+
+    map<string, SalesCounts> byName;
+    vector<SalesCounts> serial;
+    vector<SalesCounts> parallel;
+    double mapTime = measureMilliseconds(repeats, [&]() { byName.clear(); }, [&]() {
+        for (int row = 0; row < rowCount; row++) {
+            SalesCounts& counts = byName[string(brokerNames[brokerIds[row]].c_str())];
+            counts.total++;
+            counts.sold += (statuses[row] == SOLD);
+        }
+    });
+    double serialTime = measureMilliseconds(repeats, []() {},
+        [&]() { serial = groupByDenseKey<SalesCounts>(brokerIds.data(), rowCount, brokerCount, accumulate, 1); });
+    double parallelTime = measureMilliseconds(repeats, []() {},
+        [&]() { parallel = groupByDenseKey<SalesCounts>(brokerIds.data(), rowCount, brokerCount, accumulate, threadCount); });
+
+    bool matches = serial == parallel;
+    for (int id = 0; id < brokerCount && matches; id++) {
+        auto found = byName.find(brokerNames[id]);
+        matches = found == byName.end() ? serial[id].total == 0 : found->second == serial[id];
+    }
+    printf("BENCH group n=%zu map_ms=%.1f dense_ms=%.1f parallel_ms=%.1f threads=%d speedup=%.2f%s\n", count, mapTime,
+           serialTime, parallelTime, threadCount, parallelTime > 0 ? mapTime / parallelTime : 0.0, matches ? "" : " MISMATCH");
+    return matches;
+}
+
+/**
+ * @brief Сравнява две колони с цени на кв.м., като приема NaN за равно на NaN.
+ */
+static bool sameValues(const vector<double>& a, const vector<double>& b) {
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i] != b[i] && !(a[i] != a[i] && b[i] != b[i])) {
+            return false;
+        }
+    }
+    return a.size() == b.size();
+}
+
+/**
+ * Сравнява скаларните и векторизираните ядра за цена на кв.м.: делението на колоната с цени
+ * на колоната с площи и отбелязването на стойностите на повече от 3 стандартни отклонения
+ * от средното на района. Около 1% от имотите са без площ, а около 0.5% са с много висока цена.
+ */
+static bool benchmarkSquareMetre(size_t count) {
+    const int areaCount = 300;
+    vector<double> prices = generatePrices(count);
+    mt19937 generator(20240604);
+    uniform_int_distribution<int> areaDistribution(0, 149);
+    uniform_int_distribution<uint32_t> keyDistribution(0, areaCount - 1);
+    uniform_int_distribution<int> percentDistribution(0, 199);
+    vector<double> totalAreas(count);
+    vector<uint32_t> areaIds(count);
+    for (size_t i = 0; i < count; i++) {
+        int percent = percentDistribution(generator);
+        totalAreas[i] = percent < 2 ? 0.0 : 30.0 + areaDistribution(generator);
+        prices[i] *= percent == 2 ? 50.0 : 1.0;
+        areaIds[i] = keyDistribution(generator);
+    }
+
+    int rowCount = (int)count;
+    int repeats = count <= 1000000 ? 5 : 2;
+    vector<double> scalar(count);
+    vector<double> vectorized(count);
+    double divideScalarTime = measureMilliseconds(repeats, []() {},
+        [&]() { computePricePerSquareMetreScalar(prices.data(), totalAreas.data(), rowCount, scalar.data()); });
+    double divideVectorTime = measureMilliseconds(repeats, []() {},
+        [&]() { computePricePerSquareMetre(prices.data(), totalAreas.data(), rowCount, vectorized.data()); });
+
+    vector<double> sums(areaCount, 0.0);
+    vector<double> squares(areaCount, 0.0);
+    vector<int> counts(areaCount, 0);
+    for (size_t i = 0; i < count; i++) {
+        if (scalar[i] == scalar[i]) {
+            sums[areaIds[i]] += scalar[i];
+            squares[areaIds[i]] += scalar[i] * scalar[i];
+            counts[areaIds[i]]++;
+        }
+    }
+    vector<double> means(areaCount, 0.0);
+    vector<double> limits(areaCount, 0.0);
+    for (int id = 0; id < areaCount; id++) {
+        means[id] = counts[id] > 0 ? sums[id] / counts[id] : 0.0;
+        limits[id] = counts[id] > 0 ? 3.0 * sqrt(max(0.0, squares[id] / counts[id] - means[id] * means[id])) : 0.0;
+    }
+
+    vector<unsigned char> scalarFlags(count);
+    vector<unsigned char> vectorFlags(count);
+    int scalarFlagged = 0;
+    int vectorFlagged = 0;
+    double flagScalarTime = measureMilliseconds(repeats, []() {}, [&]() {
+        scalarFlagged = flagDeviationsScalar(scalar.data(), areaIds.data(), means.data(), limits.data(), rowCount, scalarFlags.data());
+    });
+    double flagVectorTime = measureMilliseconds(repeats, []() {}, [&]() {
+        vectorFlagged = flagDeviations(scalar.data(), areaIds.data(), means.data(), limits.data(), rowCount, vectorFlags.data());
+    });
+
+    bool matches = sameValues(scalar, vectorized) && scalarFlags == vectorFlags && scalarFlagged == vectorFlagged;
+    printf("BENCH sqm n=%zu kernel=%s divide_scalar_ms=%.1f divide_simd_ms=%.1f divide_speedup=%.2f flag_scalar_ms=%.1f "
+           "flag_simd_ms=%.1f flag_speedup=%.2f flagged=%d%s\n", count, simdKernelName(), divideScalarTime, divideVectorTime,
+           divideVectorTime > 0 ? divideScalarTime / divideVectorTime : 0.0, flagScalarTime, flagVectorTime,
+           flagVectorTime > 0 ? flagScalarTime / flagVectorTime : 0.0, vectorFlagged, matches ? "" : " MISMATCH");
+    return matches;
+}
+
+/**
+ * @brief Генерира случаен имот с даден референтен номер: 200 брокера, 50 района, 1-8 стаи, повтарящи се цени.
+ */
+static Property generateProperty(mt19937& generator, int refNumber) {
+    Property property = {};
+    property.refNumber = refNumber;
+    snprintf(property.broker, sizeof(property.broker), "Broker %u", (unsigned)(generator() % 200));
+    snprintf(property.type, sizeof(property.type), "Type %u", (unsigned)(generator() % 6));
+    snprintf(property.area, sizeof(property.area), "Area %u", (unsigned)(generator() % 50));
+    snprintf(property.exposition, sizeof(property.exposition), "E%u", (unsigned)(generator() % 4));
+    property.price = (10000 + generator() % 990000) / 10.0;
+    property.totalArea = 30 + generator() % 150;
+    property.rooms = 1 + generator() % 8;
+    property.floor = generator() % 20;
+    property.status = (Status)(generator() % 3);
+    return property;
+}
+
+/**
+ * @brief Сравнява списъците на всеки ключ от `PostingIndex` с подредба, изчислена наново от колоните.
+ * @param keys Колоната с ключа на всеки имот.
+ * @param find Връща позициите с даден ключ във възходящ или низходящ ред по цена.
+ *
+ * Очакваният ред е по цена, а при равна цена - по позиция, и в двете посоки.
+ */
+template <typename Find>
+static bool postingsMatch(const PropertyStore& store, const vector<uint32_t>& keys, Find find) {
+    const double* prices = store.prices();
+    for (int direction = 0; direction < 2; direction++) {
+        bool sortAscending = direction == 0;
+        vector<uint32_t> order(keys.size());
+        iota(order.begin(), order.end(), 0u);
+        stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            if (keys[a] != keys[b]) return keys[a] < keys[b];
+            return sortAscending ? prices[a] < prices[b] : prices[a] > prices[b];
+        });
+        for (size_t begin = 0; begin < order.size();) {
+            size_t end = begin;
+            while (end < order.size() && keys[order[end]] == keys[order[begin]]) end++;
+            vector<uint32_t> expected(order.begin() + begin, order.begin() + end);
+            if (find(keys[order[begin]], sortAscending) != expected) {
+                return false;
+            }
+            begin = end;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Сравнява подредения индекс по едно поле с подредба на позициите по колоната, изчислена наново.
+ */
+template <typename T>
+static bool rangeIndexMatches(const PropertyStore& store, RangeField field, const T* column) {
+    vector<uint32_t> expected(store.size());
+    iota(expected.begin(), expected.end(), 0u);
+    stable_sort(expected.begin(), expected.end(), [column](uint32_t a, uint32_t b) { return column[a] < column[b]; });
+    double infinity = numeric_limits<double>::infinity();
+    return store.findInRange(field, -infinity, infinity) == expected && store.countInRange(field, -infinity, infinity) == expected.size();
+}
+
+/**
+ * @brief Проверява всички поддържани индекси на контейнера спрямо колоните му.
+ */
+static bool indexesMatch(const PropertyStore& store) {
+    int rowCount = store.size();
+    vector<uint32_t> brokerIds(store.brokerIds(), store.brokerIds() + rowCount);
+    vector<uint32_t> areaIds(store.areaIds(), store.areaIds() + rowCount);
+    vector<uint32_t> rooms(store.rooms(), store.rooms() + rowCount);
+    return postingsMatch(store, brokerIds, [&](uint32_t key, bool sortAscending) { return store.findByBroker(key, sortAscending); }) &&
+           postingsMatch(store, rooms, [&](uint32_t key, bool sortAscending) { return store.findByRooms((int)key, sortAscending); }) &&
+           postingsMatch(store, areaIds, [&](uint32_t key, bool sortAscending) { return store.findByArea(key, sortAscending); }) &&
+           rangeIndexMatches(store, RANGE_PRICE, store.prices()) && rangeIndexMatches(store, RANGE_TOTAL_AREA, store.totalAreas()) &&
+           rangeIndexMatches(store, RANGE_FLOOR, store.floors()) && rangeIndexMatches(store, RANGE_ROOMS, store.rooms()) &&
+           store.verifyAreaAggregates();
+}
+
+/**
+ * Зарежда каталога масово чрез `append`, след което редува единично добавяне чрез `add`
+ * с търсене по брокер и по ценови интервал, както при последователни команди `add` и `search`. Накрая променя
+ * и изтрива случайни имоти, проверява, че имоти с `nan` или `inf` се отхвърлят, и сравнява
+ * всички индекси с подредба, изчислена наново от колоните.
+ */
+static bool benchmarkIndex(size_t count) {
+    const int operations = 200;
+    mt19937 generator(20240605);
+    PropertyStore store;
+    int nextRefNumber = 1;
+    double loadTime = measureMilliseconds(1, []() {}, [&]() {
+        store.reserve((int)count);
+        for (size_t i = 0; i < count; i++) {
+            store.append(generateProperty(generator, nextRefNumber++));
+        }
+        store.finishAppend();
+    });
+
+    size_t found = 0;
+    double addSearchTime = measureMilliseconds(1, []() {}, [&]() {
+        for (int i = 0; i < operations; i++) {
+            int slot = store.add(generateProperty(generator, nextRefNumber++));
+            found += store.findByBroker(store.brokerIds()[slot], true).size();
+            found += store.findInRange(RANGE_PRICE, store.prices()[slot], store.prices()[slot] + 100.0).size();
+        }
+    });
+
+    for (int i = 0; i < operations / 2; i++) {
+        int slot = (int)(generator() % store.size());
+        Property property = generateProperty(generator, store.refNumbers()[slot]);
+        store.update(slot, property);
+    }
+    for (int i = 0; i < operations / 10; i++) {
+        store.remove((int)(generator() % store.size()));
+    }
+
+    bool rejected = true;
+    for (double invalid : {numeric_limits<double>::quiet_NaN(), numeric_limits<double>::infinity()}) {
+        Property property = generateProperty(generator, nextRefNumber++);
+        property.price = invalid;
+        rejected = rejected && store.add(property) == -1;
+        property.price = 1000.0;
+        property.totalArea = invalid;
+        rejected = rejected && !store.update((int)(generator() % store.size()), property);
+    }
+
+    bool matches = rejected && indexesMatch(store);
+    printf("BENCH index n=%zu load_ms=%.1f add_search_ms=%.1f per_op_us=%.1f found=%zu%s\n", count, loadTime, addSearchTime,
+           addSearchTime * 1000.0 / operations, found, matches ? "" : " MISMATCH");
+    return matches;
+}
+
+struct Benchmark {
+    const char* name;
+    bool (*run)(size_t count);
+};
+
+static const Benchmark BENCHMARKS[] = {
+    {"sort", benchmarkSort},
+    {"radix", benchmarkRadix},
+    {"group", benchmarkGroup},
+    {"sqm", benchmarkSquareMetre},
+    {"index", benchmarkIndex},
+};
+
+int runBenchmark(const char* name, const char* countText) {
+    const Benchmark* benchmark = NULL;
+    for (const Benchmark& candidate : BENCHMARKS) {
+        if (strcmp(candidate.name, name) == 0) {
+            benchmark = &candidate;
+        }
+    }
+    if (benchmark == NULL) {
+        fprintf(stderr, "ERR 0 unknown_benchmark '%s'\n", name);
+        return 2;
+    }
+
+    vector<size_t> counts = {100000, 1000000, 10000000};
+    if (countText != NULL) {
+        size_t count = 0;
+        const char* end = countText + strlen(countText);
+        from_chars_result result = from_chars(countText, end, count);
+        if (result.ec != errc() || result.ptr != end || count == 0 || count > UINT32_MAX) {
+            fprintf(stderr, "ERR 0 bad_value '%s'\n", countText);
+            return 2;
+        }
+        counts.assign(1, count);
+    }
+
+    bool allMatch = true;
+    for (size_t count : counts) {
+        allMatch = benchmark->run(count) && allMatch;
+        fflush(stdout);
+    }
+    return allMatch ? 0 : 1;
+}
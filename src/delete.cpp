@@ -15,8 +15,10 @@
 
 #include "delete.h"    
 #include "structs.h"   
+#include "store.h"     
 #include "update.h"    
 #include "file.h"      
+#include "journal.h"   
 #include "colors.h"    
 #include "add.h"       
 #include "utils.h"     
@@ -30,15 +32,13 @@ using namespace std;
  * Тази функция първо проверява дали има имоти за изтриване. След това тя
  * подканва потребителя за референтен номер на имот, търси го и
  * ако бъде намерен, иска потвърждение, преди да продължи с изтриването.
- * При потвърждение, имотът се премахва чрез изместване на следващите елементи
- * в масива, а `propertyCount` се намалява. След това данните се
- * синхронизират за целите на възстановяването.
+ * При потвърждение, имотът се премахва от контейнера, като редът на останалите
+ * имоти се запазва. След това данните се синхронизират за целите на възстановяването.
  *
- * @param properties Масив от структури `Property`, от които да се изтрива.
- * @param propertyCount Референция към цяло число, представляващо текущия брой имоти.
+ * @param store Контейнерът с имоти, от който да се изтрива.
  */
-void DeleteProperty(Property properties[], int& propertyCount) {
-    if (propertyCount == 0) {
+void DeleteProperty(PropertyStore& store) {
+    if (store.empty()) {
         cout << YELLOW << getTranslatedString("NO_PROPERTIES_TO_DELETE") << RESET << endl;
         return;
     }
@@ -47,7 +47,7 @@ void DeleteProperty(Property properties[], int& propertyCount) {
     int refNumber = getValidNumericInput<int>((CYAN + getTranslatedString("PROMPT_REF_NUMBER_TO_DELETE") + RESET).c_str());
 
     
-    int index = getPropertyByRefNumber(refNumber, properties, propertyCount);
+    int index = getPropertyByRefNumber(refNumber, store);
     if (index == -1) {
         cout << RED << getTranslatedString("ERROR_PROPERTY_NOT_FOUND_REF") << RESET << endl;
         return;
@@ -60,14 +60,9 @@ void DeleteProperty(Property properties[], int& propertyCount) {
     }
 
     
-    for (int i = index; i < propertyCount - 1; i++) {
-        properties[i] = properties[i + 1];
-    }
-
-    propertyCount--; 
+    removePropertyWithJournal(store, index);
 
     cout << GREEN << getTranslatedString("PROPERTY_DELETED_SUCCESS_PART1") << " " << refNumber << " " << getTranslatedString("PROPERTY_DELETED_SUCCESS_PART2") << RESET << endl;
-    syncDataToRecoveryFiles(properties, propertyCount); 
 }
 
 /**
@@ -75,15 +70,14 @@ void DeleteProperty(Property properties[], int& propertyCount) {
  *
  * Тази функция първо проверява дали има имоти за изтриване. След това тя
  * иска изрично потвърждение от потребителя, преди да изчисти всички имоти.
- * При потвърждение, `propertyCount` се нулира до нула, което ефективно изчиства
- * масива от имоти. След това данните се синхронизират за целите на възстановяването.
+ * При потвърждение, контейнерът се изчиства. След това данните се синхронизират
+ * за целите на възстановяването.
  * Тази операция е необратима без възстановяване от резервни файлове.
  *
- * @param properties Масив от структури `Property`, които да бъдат изчистени. (Съдържанието е логически изчистено чрез propertyCount = 0)
- * @param propertyCount Референция към цяло число, представляващо текущия брой имоти.
+ * @param store Контейнерът с имоти, който да бъде изчистен.
  */
-void DeleteAllProperties(Property properties[], int& propertyCount) {
-    if (propertyCount == 0) {
+void DeleteAllProperties(PropertyStore& store) {
+    if (store.empty()) {
         cout << YELLOW << getTranslatedString("NO_PROPERTIES_TO_DELETE") << RESET << endl;
         return;
     }
@@ -94,8 +88,7 @@ void DeleteAllProperties(Property properties[], int& propertyCount) {
         return;
     }
 
-    propertyCount = 0; 
+    clearPropertiesWithJournal(store); 
 
     cout << GREEN << getTranslatedString("ALL_PROPERTIES_DELETED_SUCCESS") << RESET << endl;
-    syncDataToRecoveryFiles(properties, propertyCount); 
 }
\ No newline at end of file
@@ -0,0 +1,41 @@
+/**
+ * @file dictionary.cpp
+ * @brief Имплементация на речника за кодиране на текстови стойности, деклариран в `dictionary.h`.
+ */
+
+#include "dictionary.h"
+
+using namespace std;
+
+uint32_t StringDictionary::intern(const char* value) {
+    auto it = ids.find(value);
+    if (it != ids.end()) {
+        return it->second;
+    }
+
+    uint32_t id = (uint32_t)values.size();
+    values.push_back(value);
+    ids.emplace(values.back(), id);
+    return id;
+}
+
+int64_t StringDictionary::find(const char* value) const {
+    auto it = ids.find(value);
+    if (it == ids.end()) {
+        return -1;
+    }
+    return it->second;
+}
+
+const char* StringDictionary::lookup(uint32_t id) const {
+    return values[id].c_str();
+}
+
+int StringDictionary::size() const {
+    return (int)values.size();
+}
+
+void StringDictionary::clear() {
+    values.clear();
+    ids.clear();
+}
@@ -11,9 +11,12 @@
 
 #include <iostream>    
 #include <iomanip>     
+#include <vector>      
 
 #include "display.h"   
 #include "structs.h"   
+#include "store.h"     
+#include "query.h"     
 #include "colors.h"    
 #include "localization.h" 
 
@@ -40,14 +43,14 @@ bool isPropertiesEmpty(int propertyCount) {
 /**
  * @brief Показва подробната информация за един имот на конзолата.
  *
- * Тази функция форматира и отпечатва всички атрибути на дадена структура `Property`.
+ * Тази функция форматира и отпечатва всички атрибути на даден имот.
  * Тя използва `iomanip` за последователно разстояние и прецизност на плаващата запетая, и
  * `localization.h` за показване на имена на полета и статус на текущия език.
  * Това осигурява стандартизирано и удобно за потребителя представяне на данните за имоти.
  *
- * @param prop Постоянна референция към структурата `Property`, чиито детайли трябва да бъдат показани.
+ * @param prop Изглед към имота, чиито детайли трябва да бъдат показани.
  */
-void displayPropertyDetails(const Property &prop) {
+void displayPropertyDetails(const PropertyView &prop) {
     cout << left; 
     cout << "  " << setw(15) << getTranslatedString("PROPERTY_DETAILS_REF_NUMBER") << prop.refNumber << endl;
     cout << "  " << setw(15) << getTranslatedString("PROPERTY_DETAILS_BROKER_NAME") << prop.broker << endl;
@@ -70,47 +73,43 @@ void displayPropertyDetails(const Property &prop) {
  * `displayPropertyDetails` за всеки от тях. Всеки имот е предшестван от
  * локализирано заглавие, указващо неговия пореден номер в списъка.
  *
- * @param properties Постоянен масив от структури `Property` за показване.
- * @param propertyCount Броят на валидните имоти в масива.
+ * @param store Контейнерът с имоти за показване.
  */
-void displayAllProperties(const Property properties[], int propertyCount) {
-    if (isPropertiesEmpty(propertyCount)) return; 
+void displayAllProperties(const PropertyStore& store) {
+    if (isPropertiesEmpty(store.size())) return; 
 
     
-    for (int i = 0; i < propertyCount; i++) {
+    for (int i = 0; i < store.size(); i++) {
         cout << YELLOW << "--- " << getTranslatedString("PROPERTY_HEADER") << " #" << i + 1 << " ---" << RESET << endl;
-        displayPropertyDetails(properties[i]);
+        displayPropertyDetails(store.view(i));
     }
 }
 
 /**
  * @brief Показва само имотите, които са маркирани като ПРОДАДЕНИ.
  *
- * Тази функция проверява дали списъкът с имоти е празен. Ако не е, тя итерира
- * през всички имоти, показвайки само тези, чийто `status` е `SOLD`.
+ * Тази функция проверява дали списъкът с имоти е празен. Ако не е, тя избира
+ * имотите, чийто `status` е `SOLD`, със заявка `Query::status` и ги показва по ред.
  * Тя включва локализирано заглавие и брои намерените продадени имоти.
  * Ако не бъдат намерени продадени имоти, се показва специфично локализирано съобщение.
  *
- * @param properties Постоянен масив от структури `Property` за филтриране и показване.
- * @param propertyCount Броят на валидните имоти в масива.
+ * @param store Контейнерът с имоти за филтриране и показване.
  */
-void displaySoldProperties(const Property properties[], int propertyCount) {
-    if (isPropertiesEmpty(propertyCount)) return; 
+void displaySoldProperties(const PropertyStore& store) {
+    if (isPropertiesEmpty(store.size())) return; 
 
     bool isFound = false; 
     int foundCount = 0;   
 
     
-    for (int i = 0; i < propertyCount; i++) {
-        if (properties[i].status == SOLD) {
-            if (!isFound) { 
-                cout << YELLOW << "--- " << getTranslatedString("SOLD_PROPERTIES_HEADER") << " ---" << RESET << endl;
-                isFound = true;
-            }
-            cout << YELLOW << "#" << ++foundCount << RESET << endl; 
-            displayPropertyDetails(properties[i]);
+    Query::status(SOLD).evaluate(store).forEach([&](uint32_t slot) {
+        if (!isFound) { 
+            cout << YELLOW << "--- " << getTranslatedString("SOLD_PROPERTIES_HEADER") << " ---" << RESET << endl;
+            isFound = true;
         }
-    }
+        cout << YELLOW << "#" << ++foundCount << RESET << endl; 
+        displayPropertyDetails(store.view(slot));
+    });
 
     
     if (!isFound) {
@@ -121,38 +120,46 @@ void displaySoldProperties(const Property properties[], int propertyCount) {
 /**
  * @brief Показва имоти с най-голяма обща площ.
  *
- * Тази функция първо проверява дали списъкът с имоти е празен. Ако не е, тя определя
- * максималната `totalArea` сред всички имоти. След това тя итерира през
- * имотите отново, показвайки детайлите на всички имоти, които съвпадат с тази
- * максимална площ. Тя обработва случаи, когато няма имоти с положителна площ.
+ * Тази функция първо проверява дали списъкът с имоти е празен. Ако не е, тя взема
+ * максималната `totalArea` от края на подредения индекс по обща площ, а след това
+ * извлича от същия индекс всички имоти с тази площ, без да обхожда каталога.
+ * Тя обработва случаи, когато няма имоти с положителна площ.
  *
- * @param properties Постоянен масив от структури `Property` за анализ и показване.
- * @param propertyCount Броят на валидните имоти в масива.
+ * @param store Контейнерът с имоти за анализ и показване.
  */
-void displayLargestProperties(const Property properties[], int propertyCount) {
-    if (isPropertiesEmpty(propertyCount)) return; 
+void displayLargestProperties(const PropertyStore& store) {
+    if (isPropertiesEmpty(store.size())) return; 
 
-    double maxTotalArea = 0.0; 
-    
-    for (int i = 0; i < propertyCount; i++) {
-        if (properties[i].totalArea > maxTotalArea) {
-            maxTotalArea = properties[i].totalArea;
-        }
-    }
+    vector<uint32_t> largest = store.findTop(RANGE_TOTAL_AREA, 1, true);
+    double maxTotalArea = store.totalAreas()[largest[0]]; 
 
     
-    if (maxTotalArea == 0.0) {
+    if (maxTotalArea <= 0.0) {
         cout << YELLOW << getTranslatedString("NO_PROPERTIES_WITH_AREA_GREATER_THAN_ZERO") << RESET << endl;
         return;
     }
 
     cout << YELLOW << "--- " << getTranslatedString("LARGEST_PROPERTIES_HEADER") << " (" << fixed << setprecision(2) << maxTotalArea << " " << getTranslatedString("SQ_M") << ") ---" << RESET << endl;
-    int foundCount = 0; 
+    vector<uint32_t> slots = store.findInRange(RANGE_TOTAL_AREA, maxTotalArea, maxTotalArea);
     
-    for (int i = 0; i < propertyCount; i++) {
-        if (properties[i].totalArea == maxTotalArea) {
-            cout << YELLOW << "#" << ++foundCount << RESET << endl; 
-            displayPropertyDetails(properties[i]);
-        }
+    for (size_t i = 0; i < slots.size(); i++) {
+        cout << YELLOW << "#" << i + 1 << RESET << endl; 
+        displayPropertyDetails(store.view(slots[i]));
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Показва имотите на дадените позиции в реда на позициите.
+ *
+ * Използва се за резултатите от търсене: всеки имот се чете от колоните на контейнера
+ * чрез изглед, така че нито позициите, нито записите се копират.
+ *
+ * @param store Контейнерът с имоти.
+ * @param slots Позициите на имотите за показване.
+ */
+void displayPropertyList(const PropertyStore& store, SlotSpan slots) {
+    for (size_t i = 0; i < slots.size(); i++) {
+        cout << YELLOW << "--- " << getTranslatedString("PROPERTY_HEADER") << " #" << i + 1 << RESET << endl;
+        displayPropertyDetails(store.view(slots[i]));
+    }
+}
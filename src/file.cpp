@@ -15,9 +15,17 @@
 #include <cstdlib>     
 #include <string>      
 #include <algorithm>   
+#include <vector>      
+#include <utility>     
+#include <cstdio>      
+#include <cstdint>     
 
 #include "file.h"      
 #include "structs.h"   
+#include "store.h"     
+#include "journal.h"   
+#include "mapping.h"   
+#include "parse.h"     
 #include "colors.h"    
 #include "utils.h"     
 #include "localization.h" 
@@ -41,19 +49,147 @@ const string USER_BINARY_FILENAME = BASE_DIR + "/data/properties_backup.dat";
 const string USER_TEXT_FILENAME = BASE_DIR + "/data/properties_report.txt";   
 const string SYNC_TEXT_FILENAME = BASE_DIR + "/data/recovery/sync.txt";       
 const string SYNC_BINARY_FILENAME = BASE_DIR + "/data/recovery/sync.dat";     
+const string SYNC_JOURNAL_FILENAME = BASE_DIR + "/data/recovery/sync.wal";    
+
+
+const int RECORD_CHUNK_SIZE = 256;
+
+/**
+ * @brief Заглавка на двоичните файлове с имоти (`properties_backup.dat` и `sync.dat`).
+ *
+ * След заглавката следват `count` записа `Property` с размер `recordSize` байта.
+ * Размерът на заглавката е кратен на 8, така че записите в проектирания файл са подравнени.
+ */
+struct BinaryFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    int64_t count;
+};
+
+const char BINARY_FILE_MAGIC[8] = {'R', 'E', 'A', 'G', 'E', 'N', 'C', 'Y'};
+const uint32_t BINARY_FILE_VERSION = 2;
+
+/**
+ * @brief Резултат от четенето на двоичен файл с имоти.
+ */
+enum BinaryLoadResult { BINARY_LOADED, BINARY_NOT_FOUND, BINARY_CORRUPTED, BINARY_INCOMPLETE };
+
+/**
+ * @brief Записва заглавката и записите на всички имоти в отворен двоичен файл.
+ *
+ * Записите се прехвърлят на порции от `RECORD_CHUNK_SIZE`, така че да не се
+ * изисква един непрекъснат масив с всички имоти.
+ *
+ * @param binaryFile Отворен за запис двоичен файл.
+ * @param store Контейнерът с имоти за запис.
+ * @return `true`, ако всички записи са предадени на файла; `false` при грешка при запис.
+ */
+static bool writePropertyRecords(FILE* binaryFile, const PropertyStore& store) {
+    int propertyCount = store.size();
+
+    BinaryFileHeader header;
+    memcpy(header.magic, BINARY_FILE_MAGIC, sizeof(header.magic));
+    header.version = BINARY_FILE_VERSION;
+    header.recordSize = sizeof(Property);
+    header.count = propertyCount;
+    if (fwrite(&header, sizeof(header), 1, binaryFile) != 1) {
+        return false;
+    }
+
+    vector<Property> chunk;
+    chunk.reserve(RECORD_CHUNK_SIZE);
+    for (int i = 0; i < propertyCount; i++) {
+        chunk.push_back(store.get(i));
+        if ((int)chunk.size() == RECORD_CHUNK_SIZE || i == propertyCount - 1) {
+            if (fwrite(chunk.data(), sizeof(Property), chunk.size(), binaryFile) != chunk.size()) {
+                return false;
+            }
+            chunk.clear();
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Зарежда двоичен файл с имоти в контейнера чрез проектиране на файла в паметта.
+ *
+ * Проекцията спестява само междинния буфер за четене: контейнерът не може да работи
+ * директно върху нея, защото файлът съдържа цели записи `Property`, а контейнерът пази
+ * отделни колони с речникови идентификатори вместо текст. Затова всеки запис се копира,
+ * текстовите му полета се добавят в речниците и индексите се построяват наново, т.е.
+ * зареждането остава O(n) по броя на записите. Поддържат се както файлове със заглавка
+ * `BinaryFileHeader`, така и по-старият формат, който започва само с броя на записите
+ * като `int`. Записите в стария формат започват от отместване 4 и не са подравнени,
+ * затова всеки запис се прехвърля чрез `memcpy`. Запис с цена или площ, която не е крайно
+ * число, означава повреден файл. При повреден или непълен файл контейнерът се изчиства.
+ *
+ * @param path Пътят до двоичния файл.
+ * @param store Контейнерът, който ще бъде попълнен.
+ * @return Резултатът от зареждането.
+ */
+static BinaryLoadResult readPropertyFile(const char* path, PropertyStore& store) {
+    store.clear();
+
+    MappedFile mapping;
+    if (!mapping.open(path)) {
+        return BINARY_NOT_FOUND;
+    }
+
+    const char* data = mapping.data();
+    size_t fileSize = mapping.size();
+    size_t recordsOffset = 0;
+    int64_t propertyCount = 0;
+
+    BinaryFileHeader header;
+    if (fileSize >= sizeof(header) && memcmp(data, BINARY_FILE_MAGIC, sizeof(BINARY_FILE_MAGIC)) == 0) {
+        memcpy(&header, data, sizeof(header));
+        if (header.version != BINARY_FILE_VERSION || header.recordSize != sizeof(Property)) {
+            return BINARY_CORRUPTED;
+        }
+        propertyCount = header.count;
+        recordsOffset = sizeof(header);
+    } else if (fileSize >= sizeof(int)) {
+        int legacyCount;
+        memcpy(&legacyCount, data, sizeof(int));
+        propertyCount = legacyCount;
+        recordsOffset = sizeof(int);
+    } else {
+        return BINARY_CORRUPTED;
+    }
+
+    if (propertyCount < 0 || propertyCount > INT32_MAX) {
+        return BINARY_CORRUPTED;
+    }
+    if ((fileSize - recordsOffset) / sizeof(Property) < (size_t)propertyCount) {
+        return BINARY_INCOMPLETE;
+    }
+
+    store.reserve((int)propertyCount);
+    const char* record = data + recordsOffset;
+    for (int64_t i = 0; i < propertyCount; i++, record += sizeof(Property)) {
+        Property property;
+        memcpy(&property, record, sizeof(Property));
+        if (store.append(property) == -1) {
+            store.clear();
+            return BINARY_CORRUPTED;
+        }
+    }
+    store.finishAppend();
+    return BINARY_LOADED;
+}
 
 /**
- * @brief Записва текущия масив от имоти в указан от потребителя двоичен файл.
+ * @brief Записва текущите имоти в указан от потребителя двоичен файл.
  *
  * Тази функция първо гарантира, че целевата директория съществува. След това подканва
  * потребителя за потвърждение, ако файлът вече съществува, за да се предотвратят случайни презаписвания.
- * Данните за имотите се записват в суров двоичен формат, започвайки с `propertyCount`
- * и последвани от масива от структури `Property`.
+ * Данните за имотите се записват в двоичен формат, започвайки със заглавка `BinaryFileHeader`
+ * и последвани от записите `Property`.
  *
- * @param properties Постоянен масив от структури `Property` за запис.
- * @param propertyCount Броят на валидните имоти в масива.
+ * @param store Контейнерът с имоти за запис.
  */
-void saveToBinaryFile(const Property properties[], int propertyCount) {
+void saveToBinaryFile(const PropertyStore& store) {
     
     ensureDirectoryExists((BASE_DIR + "/data").c_str());
 
@@ -64,87 +200,61 @@ void saveToBinaryFile(const Property properties[], int propertyCount) {
     }
 
     
-    FILE* binaryFile = fopen(USER_BINARY_FILENAME.c_str(), "wb");
-    if (binaryFile == NULL) {
+    if (!writeBinaryFile(USER_BINARY_FILENAME.c_str(), store)) {
         cout << RED << getTranslatedString("ERROR_OPEN_FILE_WRITE") << RESET << endl;
         return; 
     }
 
-    
-    fwrite(&propertyCount, sizeof(int), 1, binaryFile);
-    
-    if (propertyCount > 0) {
-        fwrite(properties, sizeof(Property), propertyCount, binaryFile);
-    }
-    fclose(binaryFile); 
-
     cout << GREEN << getTranslatedString("DATA_SAVED_SUCCESS") << " '" << USER_BINARY_FILENAME << "'." << RESET << endl;
 }
 
 /**
  * @brief Зарежда данни за имоти от указан от потребителя двоичен файл в паметта на приложението.
  *
- * Тази функция се опитва да отвори двоичен файл и да прочете данни за имоти от него.
- * Тя прочита броя на имотите първо, след това масива от структури `Property`.
- * Включена е надеждна проверка за грешки за обработка на случаи, когато файлът не е намерен,
- * е повреден или ако броят на имотите надвишава капацитета на приложението.
+ * Тази функция проектира двоичния файл в паметта само за четене и попълва контейнера
+ * директно от проекцията чрез `readPropertyFile`. Заглавката на файла се проверява
+ * (идентификатор, версия, размер на записа и брой записи), а файловете в стария формат
+ * без заглавка също се разпознават. Включена е надеждна проверка за грешки за обработка на случаи,
+ * когато файлът не е намерен или е повреден.
  *
- * @param properties Масив от структури `Property`, където ще бъдат съхранени заредените данни.
- * @param propertyCount Референция към цяло число, което ще бъде актуализирано с броя на заредените имоти.
+ * @param store Контейнерът, в който ще бъдат заредени имотите.
  */
-void loadFromBinaryFile(Property properties[], int& propertyCount) {
+void loadFromBinaryFile(PropertyStore& store) {
     
-    FILE* binaryFile = fopen(USER_BINARY_FILENAME.c_str(), "rb");
-    if (binaryFile == NULL) {
-        cout << RED << getTranslatedString("ERROR_FILE_NOT_FOUND") << RESET << endl;
-        propertyCount = 0; 
-        return;
-    }
+    BinaryLoadResult result = readPropertyFile(USER_BINARY_FILENAME.c_str(), store);
 
-    
-    size_t readCount = fread(&propertyCount, sizeof(int), 1, binaryFile);
-    
-    if (readCount != 1 || propertyCount < 0) {
-        cout << RED << getTranslatedString("ERROR_FILE_CORRUPTED") << RESET << endl;
-        fclose(binaryFile);
-        propertyCount = 0;
-        return;
-    }
-
-    
-    if (propertyCount > 0 && propertyCount <= MAX_PROPERTIES) {
-        size_t readProps = fread(properties, sizeof(Property), propertyCount, binaryFile);
-        
-        if (readProps != (size_t)propertyCount) {
+    switch (result) {
+        case BINARY_NOT_FOUND:
+            cout << RED << getTranslatedString("ERROR_FILE_NOT_FOUND") << RESET << endl;
+            return;
+        case BINARY_CORRUPTED:
+            cout << RED << getTranslatedString("ERROR_FILE_CORRUPTED") << RESET << endl;
+            return;
+        case BINARY_INCOMPLETE:
             cout << RED << getTranslatedString("ERROR_FILE_CORRUPTED_INCOMPLETE") << RESET << endl;
-            propertyCount = 0;
             return;
-        }
+        case BINARY_LOADED:
+            break;
+    }
 
-        cout << GREEN << getTranslatedString("DATA_LOADED_SUCCESS_COUNT") << " " << propertyCount << " " << getTranslatedString("DATA_LOADED_SUCCESS_FROM_FILE") << " '" << USER_BINARY_FILENAME << "'." << RESET << endl;
-    } else if (propertyCount > MAX_PROPERTIES) {
-        
-        cout << RED << getTranslatedString("ERROR_CAPACITY_EXCEEDED_FILE_COUNT") << " (" << propertyCount << ") " << getTranslatedString("ERROR_CAPACITY_EXCEEDED_MAX_CAPACITY") << RESET << endl;
-        propertyCount = 0; 
-    } else { 
+    if (store.empty()) {
         cout << YELLOW << getTranslatedString("FILE_EMPTY_LOADED_ZERO") << RESET << endl;
-        propertyCount = 0;
+        return;
     }
 
-    fclose(binaryFile); 
+    cout << GREEN << getTranslatedString("DATA_LOADED_SUCCESS_COUNT") << " " << store.size() << " " << getTranslatedString("DATA_LOADED_SUCCESS_FROM_FILE") << " '" << USER_BINARY_FILENAME << "'." << RESET << endl;
 }
 
 /**
- * @brief Записва текущия масив от имоти в четим текстов файл като отчет.
+ * @brief Записва текущите имоти в четим текстов файл като отчет.
  *
  * Тази функция форматира данните за имоти в табличен текстов отчет. Тя включва
  * заглавки и разделители за четимост и използва локализирани низове за имена на колони.
  * Подобно на `saveToBinaryFile`, тя проверява за съществуване на директория и потвърждава презаписвания.
  *
- * @param properties Постоянен масив от структури `Property` за докладване.
- * @param propertyCount Броят на валидните имоти в масива.
+ * @param store Контейнерът с имоти за докладване.
  */
-void saveToUserFriendlyTextFile(const Property properties[], int propertyCount) {
+void saveToUserFriendlyTextFile(const PropertyStore& store) {
     
     ensureDirectoryExists((BASE_DIR + "/data").c_str());
     
@@ -165,8 +275,8 @@ void saveToUserFriendlyTextFile(const Property properties[], int propertyCount)
     fprintf(file, "---------------------------------------------------------------------------------------------------------------------------------\n");
 
     
-    for (int i = 0; i < propertyCount; i++) {
-        const Property& prop = properties[i];
+    for (int i = 0; i < store.size(); i++) {
+        PropertyView prop = store.view(i);
         fprintf(file, "| %-4d | %-15s | %-15s | %-15s | %-10s | %-12.2f | %-10.2f | %-5d | %-5d | %-10s |\n",
                 prop.refNumber, prop.broker, prop.type, prop.area, prop.exposition,
                 prop.price, prop.totalArea, prop.rooms, prop.floor, getStatusString(prop.status).c_str());
@@ -177,107 +287,79 @@ void saveToUserFriendlyTextFile(const Property properties[], int propertyCount)
 }
 
 /**
- * @brief Записва текущия масив от имоти в обикновен текстов файл за синхронизация/възстановяване.
+ * @brief Записва текущите имоти в обикновен текстов файл за синхронизация/възстановяване.
  *
  * Тази функция записва данни за имоти в текстов файл във формат, разделен с | (pipe).
  * Този формат е оптимизиран за програмно анализиране по време на зареждане/възстановяване на данни,
- * а не за човешка четимост. Обработката на грешки при отваряне на файл е минимална, тъй като
+ * а не за човешка четимост. При грешка функцията само връща `false`, тъй като
  * това е предимно вътрешен механизъм за възстановяване.
  *
- * @param properties Постоянен масив от структури `Property` за синхронизация.
- * @param propertyCount Броят на валидните имоти в масива.
+ * @param store Контейнерът с имоти за синхронизация.
+ * @return `true`, ако файлът е записан изцяло; `false` в противен случай.
  */
-void saveToSyncTextFile(const Property properties[], int propertyCount) {
+bool saveToSyncTextFile(const PropertyStore& store) {
     
     FILE* file = fopen(SYNC_TEXT_FILENAME.c_str(), "w");
-    if (file == NULL) return; 
+    if (file == NULL) return false; 
 
     
-    for (int i = 0; i < propertyCount; i++) {
-        const Property& prop = properties[i];
-        fprintf(file, "%d|%s|%s|%s|%s|%.2f|%.2f|%d|%d|%d\n",
-                prop.refNumber, prop.broker, prop.type, prop.area, prop.exposition,
-                prop.price, prop.totalArea, prop.rooms, prop.floor, prop.status);
+    for (int i = 0; i < store.size(); i++) {
+        writeSyncRecord(file, store.view(i));
     }
-    fclose(file); 
+    bool written = !ferror(file);
+    return fclose(file) == 0 && written;
+}
+
+/**
+ * @brief Записва един имот като ред, разделен с | (pipe), завършващ с нов ред.
+ *
+ * Същият формат се използва от `sync.txt` и от записите в журнала на промените.
+ *
+ * @param file Отворен за запис текстов файл.
+ * @param prop Имотът за запис.
+ */
+void writeSyncRecord(FILE* file, const PropertyView& prop) {
+    fprintf(file, "%d|%s|%s|%s|%s|%.2f|%.2f|%d|%d|%d\n",
+            prop.refNumber, prop.broker, prop.type, prop.area, prop.exposition,
+            prop.price, prop.totalArea, prop.rooms, prop.floor, prop.status);
+}
+
+/**
+ * @brief Проектира `sync.txt` в паметта и го разчита в контейнера чрез `parseSyncText`.
+ *
+ * @param store Контейнерът, който ще бъде попълнен.
+ * @return `true`, ако файлът съществува и е прочетен; `false` в противен случай.
+ */
+static bool readSyncTextFile(PropertyStore& store) {
+    MappedFile mapping;
+    if (!mapping.open(SYNC_TEXT_FILENAME.c_str())) {
+        return false;
+    }
+    store.clear();
+    parseSyncText(mapping.data(), mapping.size(), store);
+    return true;
 }
 
 /**
  * @brief Зарежда данни за имоти от текстов файл за синхронизация в паметта на приложението.
  *
- * Тази функция прочита данни за имоти от текстов файл, разделен с | (pipe). Тя анализира
- * всеки ред, конструира структури `Property` и ги съхранява във временен масив.
+ * Тази функция проектира в паметта текстов файл, разделен с | (pipe), и го разчита чрез
+ * `parseSyncText` директно във временен контейнер (при голям файл - в няколко нишки).
  * След зареждане, тя подканва потребителя за потвърждение за зареждане на тези имоти
  * в основните данни на приложението, осигурявайки механизъм за възстановяване.
  *
- * @param properties Масив от структури `Property`, където ще бъдат съхранени заредените данни.
- * @param propertyCount Референция към цяло число, което ще бъде актуализирано с броя на заредените имоти.
+ * @param store Контейнерът, в който ще бъдат заредени имотите.
  */
-void loadFromSyncTextFile(Property properties[], int& propertyCount) {
+void loadFromSyncTextFile(PropertyStore& store) {
     
-    FILE* file = fopen(SYNC_TEXT_FILENAME.c_str(), "r");
-    if (!file) {
-        propertyCount = 0; 
+    PropertyStore recovered;
+    if (!readSyncTextFile(recovered)) {
         return;
     }
 
-    Property tempProps[MAX_PROPERTIES]; 
-    int tempCount = 0;                  
-
-    
-    while (tempCount < MAX_PROPERTIES) {
-        int ref, rooms, floor, statusInt;
-        double price, totalArea;
-        char broker[50], type[50], area[50], exposition[20];
-
-        
-        
-        
-        int itemsRead = fscanf(file,
-            "%d|%49[^|]|%49[^|]|%49[^|]|%19[^|]|%lf|%lf|%d|%d|%d\n",
-            &ref, broker, type, area, exposition,
-            &price, &totalArea, &rooms, &floor, &statusInt);
-
-        if (itemsRead != 10) {
-            
-            break;
-        }
-
-        
-        Property& prop = tempProps[tempCount];
-        prop.refNumber = ref;
-        prop.price = price;
-        prop.totalArea = totalArea;
-        prop.rooms = rooms;
-        prop.floor = floor;
-
-        
-        
-        strncpy(prop.broker, broker, sizeof(prop.broker) - 1);
-        prop.broker[sizeof(prop.broker) - 1] = '\0';
-        strncpy(prop.type, type, sizeof(prop.type) - 1);
-        prop.type[sizeof(prop.type) - 1] = '\0';
-        strncpy(prop.area, area, sizeof(prop.area) - 1);
-        prop.area[sizeof(prop.area) - 1] = '\0';
-        strncpy(prop.exposition, exposition, sizeof(prop.exposition) - 1);
-        prop.exposition[sizeof(prop.exposition) - 1] = '\0';
-
-
-        
-        if (statusInt >= SOLD && statusInt <= AVAILABLE) {
-            prop.status = (Status)statusInt;
-        } else {
-            prop.status = AVAILABLE; 
-        }
-
-        tempCount++; 
-    }
-
-    fclose(file); 
-
     
+    int tempCount = recovered.size();
     if (tempCount == 0) {
-        propertyCount = 0;
         return;
     }
 
@@ -290,62 +372,137 @@ void loadFromSyncTextFile(Property properties[], int& propertyCount) {
 
     
     if (answer.empty() || tolower(answer[0]) != 'y') {
-        propertyCount = 0;
         return;
     }
 
     
-    for (int i = 0; i < tempCount; i++) {
-        properties[i] = tempProps[i];
-    }
-    propertyCount = tempCount; 
+    store = move(recovered);
 
     cout << GREEN << getTranslatedString("DATA_LOADED_SUCCESS_COUNT") << " " << tempCount << " " << getTranslatedString("DATA_LOADED_SUCCESS_FROM_SYNC_FILE") << RESET << endl;
 }
 
+/**
+ * @brief Зарежда данните от последната сесия в контейнера, без да пита потребителя.
+ *
+ * Зарежда контролната точка от `sync.dat` и прилага върху нея журнала на промените.
+ * Ако `sync.dat` липсва или е непълен (например от по-стара версия, която е пазила
+ * само `sync.txt`), използва `sync.txt`.
+ *
+ * @param store Контейнерът, който ще бъде попълнен.
+ * @return Източникът, от който са заредени данните.
+ */
+RecoverySource readRecoveryFiles(PropertyStore& store) {
+    if (readPropertyFile(SYNC_BINARY_FILENAME.c_str(), store) == BINARY_LOADED) {
+        replayJournal(SYNC_JOURNAL_FILENAME.c_str(), store);
+        return RECOVERY_CHECKPOINT;
+    }
+    if (readSyncTextFile(store)) {
+        return RECOVERY_SYNC_TEXT;
+    }
+    return RECOVERY_NONE;
+}
 
 /**
- * @brief Синхронизира текущите данни за имоти с текстови и двоични файлове за възстановяване.
+ * @brief Зарежда данните от последната сесия след потвърждение от потребителя.
  *
- * Тази функция гарантира устойчивост на данните, като записва текущото състояние на имотите
- * в определени файлове за възстановяване. Тя първо гарантира, че директорията за възстановяване съществува,
- * след това извиква `saveToSyncTextFile` и `saveToRecoveryBinaryFile`. Тази многоформатна
- * стратегия за възстановяване осигурява устойчивост срещу различни видове повреда на данните.
+ * Данните се зареждат чрез `readRecoveryFiles` във временен контейнер, за да може
+ * потребителят да откаже възстановяването.
  *
- * @param properties Постоянен масив от структури `Property` за синхронизация.
- * @param propertyCount Броят на валидните имоти в масива.
+ * @param store Контейнерът, в който ще бъдат заредени имотите.
  */
-void syncDataToRecoveryFiles(const Property properties[], int propertyCount) {
+void loadFromRecoveryFiles(PropertyStore& store) {
     
-    ensureDirectoryExists((BASE_DIR + "/data/recovery").c_str());
+    PropertyStore recovered;
+    RecoverySource source = readRecoveryFiles(recovered);
+
+    int recoveredCount = recovered.size();
+    if (recoveredCount == 0) {
+        return;
+    }
+
+    
+    cout << getTranslatedString("RECOVERY_PROMPT_PART1") << " " << recoveredCount << " " << getTranslatedString("RECOVERY_PROMPT_PART2") << " [y/n] ";
+
+    string answer;
+    getline(cin, answer);
+
+    if (answer.empty() || tolower(answer[0]) != 'y') {
+        return;
+    }
+
+    store = move(recovered);
+
+    const char* sourceKey = source == RECOVERY_SYNC_TEXT ? "DATA_LOADED_SUCCESS_FROM_SYNC_FILE" : "DATA_LOADED_SUCCESS_FROM_RECOVERY_FILES";
+    cout << GREEN << getTranslatedString("DATA_LOADED_SUCCESS_COUNT") << " " << recoveredCount << " " << getTranslatedString(sourceKey) << RESET << endl;
+}
+
+/**
+ * @brief Прави контролна точка на данните за имоти във файловете за възстановяване.
+ *
+ * Записва текущото състояние на имотите в `sync.txt` и `sync.dat`, след което изчиства
+ * журнала на промените, тъй като всички записани в него промени вече се съдържат
+ * в контролната точка. Ако `sync.dat` не бъде записан, журналът не се изчиства:
+ * предишната контролна точка остава непокътната и заедно с журнала описва текущото състояние.
+ * Директорията за възстановяване се създава само при първата контролна точка в сесията.
+ *
+ * @param store Контейнерът с имоти за синхронизация.
+ * @return `true`, ако и двата файла са записани; `false` в противен случай.
+ */
+bool syncDataToRecoveryFiles(const PropertyStore& store) {
+    static bool recoveryDirectoryReady = false;
+    if (!recoveryDirectoryReady) {
+        ensureDirectoryExists((BASE_DIR + "/data/recovery").c_str());
+        recoveryDirectoryReady = true;
+    }
+    
+    bool textSaved = saveToSyncTextFile(store);
     
-    saveToSyncTextFile(properties, propertyCount);
+    if (!saveToRecoveryBinaryFile(store)) {
+        return false;
+    }
     
-    saveToRecoveryBinaryFile(properties, propertyCount);
+    resetJournal(SYNC_JOURNAL_FILENAME.c_str());
+    return textSaved;
 }
 
 /**
- * @brief Записва текущия масив от имоти в двоичен файл за възстановяване.
+ * @brief Записва текущите имоти в двоичен файл за възстановяване.
  *
  * Това е специализирана версия на двоично записване, предназначена за автоматично
  * фоново възстановяване. Тя директно записва броя и данните за имотите
  * в предварително дефиниран двоичен файл без потребителско взаимодействие или подканване за презаписване,
  * гарантирайки, че винаги е налично скорошно архивиране.
  *
- * @param properties Постоянен масив от структури `Property` за запис.
- * @param propertyCount Броят на валидните имоти в масива.
+ * @param store Контейнерът с имоти за запис.
+ * @return `true`, ако файлът е записан; `false` в противен случай.
  */
-void saveToRecoveryBinaryFile(const Property properties[], int propertyCount) {
-    
-    FILE* binaryFile = fopen(SYNC_BINARY_FILENAME.c_str(), "wb");
-    if (binaryFile == NULL) return; 
+bool saveToRecoveryBinaryFile(const PropertyStore& store) {
     
-    fwrite(&propertyCount, sizeof(int), 1, binaryFile);
-    
-    if (propertyCount > 0) {
-        fwrite(properties, sizeof(Property), propertyCount, binaryFile);
+    return writeBinaryFile(SYNC_BINARY_FILENAME.c_str(), store);
+}
+
+/**
+ * @brief Записва всички имоти в двоичен файл на указан път, без потребителско взаимодействие.
+ *
+ * Данните се записват първо във временен файл `<path>.tmp`, който замества целевия файл
+ * чрез `rename` едва след като всички записи и затварянето му са успешни. Така при грешка
+ * (например пълен диск) съществуващият файл остава непокътнат.
+ *
+ * @param path Пътят до файла, който се създава или презаписва.
+ * @param store Контейнерът с имоти за запис.
+ * @return `true`, ако файлът е записан; `false`, ако не може да бъде отворен или записан.
+ */
+bool writeBinaryFile(const char* path, const PropertyStore& store) {
+    string temporaryPath = string(path) + ".tmp";
+    FILE* binaryFile = fopen(temporaryPath.c_str(), "wb");
+    if (binaryFile == NULL) return false;
+
+    bool written = writePropertyRecords(binaryFile, store);
+    if (fclose(binaryFile) != 0 || !written || rename(temporaryPath.c_str(), path) != 0) {
+        remove(temporaryPath.c_str());
+        return false;
     }
-    fclose(binaryFile); 
+    return true;
 }
 
 /**
@@ -0,0 +1,249 @@
+/**
+ * @file import.cpp
+ * @brief Имплементация на масовото импортиране на обяви, декларирано в `import.h`.
+ *
+ * Файлът се проектира в паметта и се обхожда ред по ред. Паметта на контейнера се заделя
+ * веднъж според броя на редовете във файла, а валидните имоти се добавят директно чрез
+ * `PropertyStore::append`; индексите се подреждат веднъж в края на импорта.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+
+#include "import.h"
+#include "add.h"
+#include "file.h"
+#include "mapping.h"
+#include "colors.h"
+#include "localization.h"
+
+using namespace std;
+
+const int IMPORT_MIN_FIELDS = 9;
+const int IMPORT_MAX_FIELDS = 10;
+
+/**
+ * @brief Разделя ред на полета по даден разделител.
+ *
+ * Интервалите около полетата се премахват. Поле, оградено с кавички, може да съдържа
+ * разделителя, а две поредни кавички в него означават една кавичка.
+ *
+ * @return Броят на полетата или `IMPORT_MAX_FIELDS + 1`, ако те са повече от допустимото.
+ */
+static int splitFields(const char* cursor, const char* end, char delimiter, vector<string>& fields) {
+    int fieldCount = 0;
+    while (true) {
+        if (fieldCount == IMPORT_MAX_FIELDS) {
+            return IMPORT_MAX_FIELDS + 1;
+        }
+        string& field = fields[fieldCount++];
+        field.clear();
+
+        while (cursor < end && (*cursor == ' ' || *cursor == '\t')) cursor++;
+
+        if (cursor < end && *cursor == '"') {
+            cursor++;
+            while (cursor < end) {
+                if (*cursor == '"') {
+                    if (cursor + 1 < end && cursor[1] == '"') {
+                        field += '"';
+                        cursor += 2;
+                        continue;
+                    }
+                    cursor++;
+                    break;
+                }
+                field += *cursor++;
+            }
+            while (cursor < end && *cursor != delimiter) cursor++;
+        } else {
+            const char* separator = (const char*)memchr(cursor, delimiter, end - cursor);
+            const char* fieldEnd = separator != NULL ? separator : end;
+            const char* trimmedEnd = fieldEnd;
+            while (trimmedEnd > cursor && (trimmedEnd[-1] == ' ' || trimmedEnd[-1] == '\t')) trimmedEnd--;
+            field.assign(cursor, trimmedEnd);
+            cursor = fieldEnd;
+        }
+
+        if (cursor >= end) {
+            return fieldCount;
+        }
+        cursor++;
+    }
+}
+
+/**
+ * @brief Разчита цялото поле като число.
+ */
+template <typename T>
+static bool parseNumber(const string& field, T& value) {
+    const char* end = field.data() + field.size();
+    from_chars_result result = from_chars(field.data(), end, value);
+    return result.ec == errc() && result.ptr == end && !field.empty();
+}
+
+/**
+ * @brief Копира текстово поле в буфер на `Property` по правилата на `getValidStringInput`.
+ *
+ * Текстът се съкращава до размера на буфера и се санитизира чрез `sanitizeString`.
+ *
+ * @return `false`, ако след санитизацията полето е празно.
+ */
+static bool copyTextField(const string& field, char* destination, size_t size) {
+    size_t length = min(field.size(), size - 1);
+    memcpy(destination, field.data(), length);
+    destination[length] = '\0';
+    sanitizeString(destination);
+    return destination[0] != '\0';
+}
+
+/**
+ * @brief Валидира полетата на един ред и попълва имота.
+ * @return `true`, ако редът е валиден; в противен случай `reason` съдържа причината.
+ */
+static bool buildProperty(const vector<string>& fields, int fieldCount, Property& property, ImportRejectReason& reason) {
+    if (fieldCount < IMPORT_MIN_FIELDS || fieldCount > IMPORT_MAX_FIELDS) {
+        reason = IMPORT_BAD_FIELD_COUNT;
+        return false;
+    }
+
+    int statusInt = AVAILABLE;
+    if (!parseNumber(fields[0], property.refNumber) || !parseNumber(fields[5], property.price) ||
+        !parseNumber(fields[6], property.totalArea) || !parseNumber(fields[7], property.rooms) ||
+        !parseNumber(fields[8], property.floor) ||
+        (fieldCount == IMPORT_MAX_FIELDS && !fields[9].empty() && !parseNumber(fields[9], statusInt)) ||
+        statusInt < SOLD || statusInt > AVAILABLE || !isValidMeasure(property.price) ||
+        !isValidMeasure(property.totalArea)) {
+        reason = IMPORT_BAD_NUMBER;
+        return false;
+    }
+    property.status = (Status)statusInt;
+
+    if (!copyTextField(fields[1], property.broker, sizeof(property.broker)) ||
+        !copyTextField(fields[2], property.type, sizeof(property.type)) ||
+        !copyTextField(fields[3], property.area, sizeof(property.area)) ||
+        !copyTextField(fields[4], property.exposition, sizeof(property.exposition))) {
+        reason = IMPORT_EMPTY_TEXT;
+        return false;
+    }
+    return true;
+}
+
+ImportResult importProperties(const char* path, PropertyStore& store) {
+    ImportResult result;
+    auto startTime = chrono::steady_clock::now();
+
+    MappedFile mapping;
+    if (!mapping.open(path)) {
+        return result;
+    }
+    result.opened = true;
+
+    const char* cursor = mapping.data();
+    const char* end = cursor + mapping.size();
+
+    size_t lineCount = count(cursor, end, '\n') + 1;
+    store.reserve(store.size() + (int)min(lineCount, (size_t)(INT32_MAX - store.size())));
+
+    vector<string> fields(IMPORT_MAX_FIELDS);
+
+    char delimiter = 0;
+    int lineNumber = 0;
+    while (cursor < end) {
+        const char* newline = (const char*)memchr(cursor, '\n', end - cursor);
+        const char* lineEnd = newline != NULL ? newline : end;
+        const char* line = cursor;
+        cursor = newline != NULL ? newline + 1 : end;
+        lineNumber++;
+
+        if (lineEnd > line && lineEnd[-1] == '\r') {
+            lineEnd--;
+        }
+        if (lineEnd == line) {
+            continue;
+        }
+
+        bool firstLine = delimiter == 0;
+        if (firstLine) {
+            delimiter = memchr(line, '|', lineEnd - line) != NULL ? '|' : ',';
+        }
+
+        int fieldCount = splitFields(line, lineEnd, delimiter, fields);
+
+        int headerRef;
+        if (firstLine && !parseNumber(fields[0], headerRef)) {
+            continue;
+        }
+        result.rowsRead++;
+
+        Property property;
+        ImportRejectReason reason;
+        bool valid = buildProperty(fields, fieldCount, property, reason);
+        if (valid && store.findByRefNumber(property.refNumber) != -1) {
+            reason = IMPORT_DUPLICATE_REF;
+            valid = false;
+        }
+
+        if (!valid) {
+            result.rejected++;
+            if ((int)result.rejectedRows.size() < IMPORT_MAX_REPORTED_ERRORS) {
+                result.rejectedRows.push_back({lineNumber, reason});
+            }
+            continue;
+        }
+
+        store.append(property);
+        result.imported++;
+    }
+    store.finishAppend();
+
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+    return result;
+}
+
+/**
+ * @brief Връща ключа за превод на причината за отхвърляне на ред.
+ */
+static const char* rejectReasonKey(ImportRejectReason reason) {
+    switch (reason) {
+        case IMPORT_BAD_FIELD_COUNT: return "IMPORT_REASON_FIELD_COUNT";
+        case IMPORT_BAD_NUMBER: return "IMPORT_REASON_NUMBER";
+        case IMPORT_EMPTY_TEXT: return "IMPORT_REASON_EMPTY_TEXT";
+        case IMPORT_DUPLICATE_REF: return "IMPORT_REASON_DUPLICATE_REF";
+    }
+    return "IMPORT_REASON_NUMBER";
+}
+
+void importPropertiesFromFile(PropertyStore& store) {
+    cout << CYAN << getTranslatedString("PROMPT_IMPORT_FILE_PATH") << RESET;
+    string path;
+    getline(cin, path);
+
+    ImportResult result = importProperties(path.c_str(), store);
+    if (!result.opened) {
+        cout << RED << getTranslatedString("ERROR_IMPORT_FILE_OPEN") << " '" << path << "'." << RESET << endl;
+        return;
+    }
+
+    double rowsPerSecond = result.seconds > 0 ? result.rowsRead / result.seconds : 0;
+    cout << GREEN << getTranslatedString("IMPORT_SUMMARY_IMPORTED") << " " << result.imported << " / " << result.rowsRead << RESET << endl;
+    cout << (result.rejected > 0 ? YELLOW : GREEN) << getTranslatedString("IMPORT_SUMMARY_REJECTED") << " " << result.rejected << RESET << endl;
+    cout << getTranslatedString("IMPORT_SUMMARY_TIME") << " " << fixed << setprecision(3) << result.seconds
+         << " (" << setprecision(0) << rowsPerSecond << " " << getTranslatedString("IMPORT_SUMMARY_RATE") << ")" << endl;
+    cout << defaultfloat << setprecision(6);
+
+    for (const ImportRejectedRow& row : result.rejectedRows) {
+        cout << YELLOW << "  " << getTranslatedString("IMPORT_REJECTED_LINE") << " " << row.lineNumber << ": " << getTranslatedString(rejectReasonKey(row.reason)) << RESET << endl;
+    }
+
+    if (result.imported > 0) {
+        syncDataToRecoveryFiles(store);
+    }
+}
@@ -0,0 +1,320 @@
+/**
+ * @file index.cpp
+ * @brief Имплементация на индексните структури, декларирани в `index.h`.
+ */
+
+#include <cstdint>
+#include <algorithm>
+
+#include "index.h"
+
+using namespace std;
+
+
+const int EMPTY_SLOT = -1;
+const size_t MIN_BUCKETS = 16;
+
+/**
+ * @brief Изчислява началната кофа за даден референтен номер.
+ *
+ * Използва мултипликативно (Фибоначи) хеширане, което разпределя добре
+ * последователни референтни номера. Броят на кофите винаги е степен на двойката.
+ */
+size_t RefNumberIndex::bucketFor(int refNumber) const {
+    uint32_t hash = (uint32_t)refNumber * 2654435769u;
+    return (size_t)hash & (buckets.size() - 1);
+}
+
+void RefNumberIndex::clear() {
+    buckets.clear();
+    used = 0;
+}
+
+void RefNumberIndex::reserve(int count) {
+    size_t needed = MIN_BUCKETS;
+    while (needed < (size_t)count * 2) {
+        needed *= 2;
+    }
+    if (needed > buckets.size()) {
+        grow(needed);
+    }
+}
+
+/**
+ * @brief Преразпределя таблицата с нов брой кофи и вмъква отново всички записи.
+ * @param newCapacity Новият брой кофи (степен на двойката).
+ */
+void RefNumberIndex::grow(size_t newCapacity) {
+    vector<Bucket> old;
+    old.swap(buckets);
+    buckets.assign(newCapacity, Bucket{0, EMPTY_SLOT});
+    used = 0;
+    for (const Bucket& bucket : old) {
+        if (bucket.slot != EMPTY_SLOT) {
+            insert(bucket.refNumber, bucket.slot);
+        }
+    }
+}
+
+void RefNumberIndex::insert(int refNumber, int slot) {
+    if ((size_t)(used + 1) * 2 > buckets.size()) {
+        grow(buckets.empty() ? MIN_BUCKETS : buckets.size() * 2);
+    }
+
+    size_t mask = buckets.size() - 1;
+    size_t i = bucketFor(refNumber);
+    while (buckets[i].slot != EMPTY_SLOT) {
+        if (buckets[i].refNumber == refNumber) return;
+        i = (i + 1) & mask;
+    }
+    buckets[i] = Bucket{refNumber, slot};
+    used++;
+}
+
+int RefNumberIndex::find(int refNumber) const {
+    if (buckets.empty()) return -1;
+
+    size_t mask = buckets.size() - 1;
+    size_t i = bucketFor(refNumber);
+    while (buckets[i].slot != EMPTY_SLOT) {
+        if (buckets[i].refNumber == refNumber) return buckets[i].slot;
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+/**
+ * @brief Премахва референтен номер чрез обратно изместване.
+ *
+ * След освобождаване на кофата, следващите записи от същата верига се придвижват назад,
+ * ако това ги доближава до началната им кофа. Така веригите остават непрекъснати
+ * и не са нужни маркери за изтрити записи.
+ */
+void RefNumberIndex::erase(int refNumber) {
+    if (buckets.empty()) return;
+
+    size_t mask = buckets.size() - 1;
+    size_t i = bucketFor(refNumber);
+    while (buckets[i].slot != EMPTY_SLOT && buckets[i].refNumber != refNumber) {
+        i = (i + 1) & mask;
+    }
+    if (buckets[i].slot == EMPTY_SLOT) return;
+
+    size_t hole = i;
+    size_t next = (hole + 1) & mask;
+    while (buckets[next].slot != EMPTY_SLOT) {
+        size_t home = bucketFor(buckets[next].refNumber);
+
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            buckets[hole] = buckets[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    buckets[hole].slot = EMPTY_SLOT;
+    used--;
+}
+
+void RefNumberIndex::shiftSlotsAfter(int slot) {
+    for (Bucket& bucket : buckets) {
+        if (bucket.slot > slot) {
+            bucket.slot--;
+        }
+    }
+}
+
+/**
+ * @brief Наредба на записите в `SortedSlotList`: по ключ, а при равен ключ - по позиция.
+ *
+ * Това е строга слаба наредба само за крайни ключове. PropertyStore гарантира това
+ * чрез `PropertyStore::isStorable`, тъй като `nan` би направил двоичното търсене
+ * в `place` и `erase` недефинирано.
+ */
+bool SortedSlotList::entryLess(const Entry& a, const Entry& b) {
+    return a.key < b.key || (a.key == b.key && a.slot < b.slot);
+}
+
+void SortedSlotList::clear() {
+    entries.clear();
+    sortedCount = 0;
+}
+
+size_t SortedSlotList::size() const {
+    return entries.size();
+}
+
+void SortedSlotList::append(double key, int slot) {
+    entries.push_back({key, (uint32_t)slot});
+}
+
+void SortedSlotList::finishAppend() {
+    if (sortedCount == entries.size()) {
+        return;
+    }
+    auto middle = entries.begin() + sortedCount;
+    if (!is_sorted(middle, entries.end(), entryLess)) {
+        sort(middle, entries.end(), entryLess);
+    }
+    if (sortedCount > 0 && entryLess(*middle, *(middle - 1))) {
+        inplace_merge(entries.begin(), middle, entries.end(), entryLess);
+    }
+    sortedCount = entries.size();
+}
+
+void SortedSlotList::place(double key, int slot) {
+    Entry entry = {key, (uint32_t)slot};
+    entries.insert(upper_bound(entries.begin(), entries.end(), entry, entryLess), entry);
+    sortedCount = entries.size();
+}
+
+void SortedSlotList::erase(double key, int slot) {
+    auto position = lower_bound(entries.begin(), entries.end(), Entry{key, (uint32_t)slot}, entryLess);
+    if (position != entries.end() && position->key == key && position->slot == (uint32_t)slot) {
+        entries.erase(position);
+        sortedCount = entries.size();
+    }
+}
+
+void SortedSlotList::shiftSlotsAfter(int slot) {
+    for (Entry& entry : entries) {
+        if (entry.slot > (uint32_t)slot) {
+            entry.slot--;
+        }
+    }
+}
+
+/**
+ * При низходящ ред списъкът се обхожда отзад напред по групи с еднакъв ключ, а всяка група
+ * се извежда отпред назад, за да бъде по-малката позиция първа, както при `sortSlotsByPrice`.
+ */
+vector<uint32_t> SortedSlotList::collect(bool sortAscending, size_t limit) const {
+    size_t count = min(limit, entries.size());
+    vector<uint32_t> slots;
+    slots.reserve(count);
+    if (sortAscending) {
+        for (size_t i = 0; i < count; i++) {
+            slots.push_back(entries[i].slot);
+        }
+    } else {
+        size_t end = entries.size();
+        while (end > 0 && slots.size() < count) {
+            size_t start = end - 1;
+            while (start > 0 && entries[start - 1].key == entries[end - 1].key) {
+                start--;
+            }
+            for (size_t i = start; i < end && slots.size() < count; i++) {
+                slots.push_back(entries[i].slot);
+            }
+            end = start;
+        }
+    }
+    return slots;
+}
+
+/**
+ * @brief Намира с двоично търсене индексите `[begin, end)` на записите с ключ в `[low, high]`.
+ */
+pair<size_t, size_t> SortedSlotList::findRange(double low, double high) const {
+    if (!(low <= high)) {
+        return make_pair((size_t)0, (size_t)0);
+    }
+    auto begin = lower_bound(entries.begin(), entries.end(), low, [](const Entry& entry, double value) { return entry.key < value; });
+    auto end = upper_bound(begin, entries.end(), high, [](double value, const Entry& entry) { return value < entry.key; });
+    return make_pair((size_t)(begin - entries.begin()), (size_t)(end - entries.begin()));
+}
+
+vector<uint32_t> SortedSlotList::collectRange(double low, double high) const {
+    pair<size_t, size_t> range = findRange(low, high);
+    vector<uint32_t> slots;
+    slots.reserve(range.second - range.first);
+    for (size_t i = range.first; i < range.second; i++) {
+        slots.push_back(entries[i].slot);
+    }
+    return slots;
+}
+
+size_t SortedSlotList::countRange(double low, double high) const {
+    pair<size_t, size_t> range = findRange(low, high);
+    return range.second - range.first;
+}
+
+double SortedSlotList::keyAt(size_t rank) const {
+    return entries[rank].key;
+}
+
+/**
+ * Най-големият ключ е последен, а първият запис с този ключ се намира с двоично търсене.
+ */
+int SortedSlotList::largestSlot() const {
+    if (entries.empty()) {
+        return -1;
+    }
+    double largest = entries.back().key;
+    auto first = lower_bound(entries.begin(), entries.end(), largest, [](const Entry& entry, double value) { return entry.key < value; });
+    return (int)first->slot;
+}
+
+void PostingIndex::clear() {
+    lists.clear();
+}
+
+void PostingIndex::insert(uint32_t key, double price, int slot) {
+    lists[key].place(price, slot);
+}
+
+void PostingIndex::append(uint32_t key, double price, int slot) {
+    lists[key].append(price, slot);
+}
+
+void PostingIndex::finishAppend() {
+    for (auto& keyAndList : lists) {
+        keyAndList.second.finishAppend();
+    }
+}
+
+/**
+ * Празните списъци се премахват.
+ */
+void PostingIndex::erase(uint32_t key, double price, int slot) {
+    auto found = lists.find(key);
+    if (found == lists.end()) {
+        return;
+    }
+    found->second.erase(price, slot);
+    if (found->second.size() == 0) {
+        lists.erase(found);
+    }
+}
+
+void PostingIndex::move(uint32_t oldKey, double oldPrice, uint32_t newKey, double newPrice, int slot) {
+    erase(oldKey, oldPrice, slot);
+    lists[newKey].place(newPrice, slot);
+}
+
+void PostingIndex::shiftSlotsAfter(int slot) {
+    for (auto& keyAndList : lists) {
+        keyAndList.second.shiftSlotsAfter(slot);
+    }
+}
+
+vector<uint32_t> PostingIndex::collect(uint32_t key, bool sortAscending, size_t limit) const {
+    auto found = lists.find(key);
+    if (found == lists.end()) {
+        return vector<uint32_t>();
+    }
+    return found->second.collect(sortAscending, limit);
+}
+
+size_t PostingIndex::count(uint32_t key) const {
+    auto found = lists.find(key);
+    return found == lists.end() ? 0 : found->second.size();
+}
+
+double PostingIndex::keyAt(uint32_t key, size_t rank) const {
+    return lists.at(key).keyAt(rank);
+}
+
+int PostingIndex::largestSlot(uint32_t key) const {
+    auto found = lists.find(key);
+    return found == lists.end() ? -1 : found->second.largestSlot();
+}
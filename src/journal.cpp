@@ -0,0 +1,212 @@
+/**
+ * @file journal.cpp
+ * @brief Имплементация на журнала на промените, деклариран в `journal.h`.
+ *
+ * Всеки ред в журнала започва с код на операцията:
+ * - `A|<запис>` - добавен имот;
+ * - `U|<стар реф. номер>|<запис>` - променен имот;
+ * - `D|<реф. номер>` - изтрит имот;
+ * - `C` - изтрити всички имоти.
+ * `<запис>` е във формата на `sync.txt`, но цената и площта се записват с `%.17g`, така че
+ * прочетената стойност съвпада побитово със записаната. Журналът остава отворен за дописване
+ * през цялата сесия. Всеки ред се записва и синхронизира с диска (`fsync`), преди промяната
+ * да бъде приложена в паметта. Имот, който контейнерът би отхвърлил (`PropertyStore::isStorable`),
+ * не се записва в журнала, за да не спре прилагането на журнала при стартиране.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <charconv>
+#include <algorithm>
+#include <unistd.h>
+
+#include "journal.h"
+#include "file.h"
+#include "mapping.h"
+#include "parse.h"
+
+using namespace std;
+
+static FILE* journalFile = NULL;
+static int entriesSinceCheckpoint = 0;
+
+/**
+ * @brief Подготвя журнала за нов ред.
+ *
+ * Първата промяна в сесията няма журнал, към който да бъде дописана, затова преди нея
+ * се прави контролна точка, която записва текущото състояние и отваря журнала.
+ *
+ * @param store Контейнерът преди промяната.
+ * @return `true`, ако журналът е отворен; `false`, ако контролната точка не е успяла.
+ */
+static bool beginEntry(const PropertyStore& store) {
+    if (journalFile == NULL) {
+        syncDataToRecoveryFiles(store);
+    }
+    return journalFile != NULL;
+}
+
+/**
+ * @brief Изпраща реда към файловата система и изчаква записа му на диска.
+ */
+static void commitEntry() {
+    fflush(journalFile);
+    fsync(fileno(journalFile));
+}
+
+/**
+ * @brief Завършва промяната, след като тя е приложена в паметта.
+ *
+ * Ако журналът не е бил отворен, промяната се записва чрез пълна контролна точка.
+ * Контролната точка презаписва целия каталог, затова интервалът расте с броя на имотите:
+ * така цената ѝ, разпределена върху записите в журнала, остава постоянна.
+ *
+ * @param store Контейнерът след промяната.
+ * @param journaled Дали промяната е записана в журнала.
+ */
+static void endEntry(const PropertyStore& store, bool journaled) {
+    if (!journaled) {
+        syncDataToRecoveryFiles(store);
+        return;
+    }
+    entriesSinceCheckpoint++;
+    if (entriesSinceCheckpoint >= max(JOURNAL_CHECKPOINT_INTERVAL, store.size())) {
+        syncDataToRecoveryFiles(store);
+    }
+}
+
+/**
+ * @brief Записва имот във формата на `sync.txt` с точните стойности на цената и площта.
+ */
+static void writeJournalRecord(const Property& property) {
+    fprintf(journalFile, "%d|%s|%s|%s|%s|%.17g|%.17g|%d|%d|%d\n",
+            property.refNumber, property.broker, property.type, property.area, property.exposition,
+            property.price, property.totalArea, property.rooms, property.floor, property.status);
+}
+
+bool addPropertyWithJournal(PropertyStore& store, const Property& property) {
+    if (!PropertyStore::isStorable(property)) {
+        return false;
+    }
+    bool journaled = beginEntry(store);
+    if (journaled) {
+        fputs("A|", journalFile);
+        writeJournalRecord(property);
+        commitEntry();
+    }
+    store.add(property);
+    endEntry(store, journaled);
+    return true;
+}
+
+bool updatePropertyWithJournal(PropertyStore& store, int slot, const Property& property) {
+    if (!PropertyStore::isStorable(property)) {
+        return false;
+    }
+    bool journaled = beginEntry(store);
+    if (journaled) {
+        fprintf(journalFile, "U|%d|", store.view(slot).refNumber);
+        writeJournalRecord(property);
+        commitEntry();
+    }
+    store.update(slot, property);
+    endEntry(store, journaled);
+    return true;
+}
+
+void removePropertyWithJournal(PropertyStore& store, int slot) {
+    bool journaled = beginEntry(store);
+    if (journaled) {
+        fprintf(journalFile, "D|%d\n", store.view(slot).refNumber);
+        commitEntry();
+    }
+    store.remove(slot);
+    endEntry(store, journaled);
+}
+
+void clearPropertiesWithJournal(PropertyStore& store) {
+    bool journaled = beginEntry(store);
+    if (journaled) {
+        fputs("C\n", journalFile);
+        commitEntry();
+    }
+    store.clear();
+    endEntry(store, journaled);
+}
+
+void resetJournal(const char* path) {
+    closeJournal();
+    journalFile = fopen(path, "w");
+    entriesSinceCheckpoint = 0;
+}
+
+void closeJournal() {
+    if (journalFile != NULL) {
+        fclose(journalFile);
+        journalFile = NULL;
+    }
+}
+
+/**
+ * @brief Прочита референтен номер и премества курсора след него.
+ */
+static bool parseRefNumber(const char*& cursor, const char* end, int& refNumber) {
+    from_chars_result result = from_chars(cursor, end, refNumber);
+    if (result.ec != errc()) {
+        return false;
+    }
+    cursor = result.ptr;
+    return true;
+}
+
+/**
+ * Журналът се проектира в паметта, така че дължината на реда не е ограничена от буфер.
+ * Ако програмата е прекъсната между записа на контролната точка и изчистването на журнала,
+ * журналът съдържа промени, които вече са в `sync.dat`. Затова добавяне на съществуващ
+ * номер и изтриване или промяна на липсващ номер се пропускат, вместо да се третират като грешка.
+ */
+int replayJournal(const char* path, PropertyStore& store) {
+    MappedFile mapping;
+    if (!mapping.open(path)) return 0;
+
+    const char* line = mapping.data();
+    const char* end = line + mapping.size();
+    int applied = 0;
+    while (line < end) {
+        const char* lineEnd = (const char*)memchr(line, '\n', end - line);
+        if (lineEnd == NULL) {
+            break;
+        }
+
+        Property property;
+        int refNumber = 0;
+        const char* cursor = line + 2;
+
+        if (lineEnd - line >= 2 && line[0] == 'A' && line[1] == '|') {
+            if (!parseSyncRecord(cursor, lineEnd, property)) break;
+            if (store.findByRefNumber(property.refNumber) == -1) {
+                store.add(property);
+            }
+        } else if (lineEnd - line >= 2 && line[0] == 'U' && line[1] == '|') {
+            if (!parseRefNumber(cursor, lineEnd, refNumber) || cursor == lineEnd || *cursor != '|') break;
+            if (!parseSyncRecord(cursor + 1, lineEnd, property)) break;
+            int slot = store.findByRefNumber(refNumber);
+            if (slot != -1) {
+                store.update(slot, property);
+            }
+        } else if (lineEnd - line >= 2 && line[0] == 'D' && line[1] == '|') {
+            if (!parseRefNumber(cursor, lineEnd, refNumber)) break;
+            int slot = store.findByRefNumber(refNumber);
+            if (slot != -1) {
+                store.remove(slot);
+            }
+        } else if (lineEnd > line && line[0] == 'C') {
+            store.clear();
+        } else {
+            break;
+        }
+        applied++;
+        line = lineEnd + 1;
+    }
+    return applied;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file kernels.cpp
+ * @brief Имплементация на векторизираните изчислителни ядра, декларирани в `kernels.h`.
+ *
+ * Вариантът с AVX2 се компилира чрез атрибута `target("avx2")`, без да са нужни специални
+ * флагове за целия проект, и се избира само ако процесорът го поддържа. Остатъкът от колоната,
+ * който не запълва цял вектор, се обработва от скаларния вариант.
+ */
+
+#include <limits>
+
+#include "kernels.h"
+
+#if defined(__GNUC__) && defined(__SSE2__) && (defined(__x86_64__) || defined(__i386__))
+#define KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+void computePricePerSquareMetreScalar(const double* prices, const double* totalAreas, int count, double* out) {
+    const double invalid = numeric_limits<double>::quiet_NaN();
+    for (int i = 0; i < count; i++) {
+        out[i] = totalAreas[i] > 0.0 ? prices[i] / totalAreas[i] : invalid;
+    }
+}
+
+int flagDeviationsScalar(const double* values, const uint32_t* keys, const double* means, const double* limits,
+                         int count, unsigned char* flags) {
+    int flagged = 0;
+    for (int i = 0; i < count; i++) {
+        double deviation = values[i] - means[keys[i]];
+        if (deviation < 0.0) {
+            deviation = -deviation;
+        }
+        flags[i] = deviation > limits[keys[i]];
+        flagged += flags[i];
+    }
+    return flagged;
+}
+
+#ifdef KERNELS_X86
+
+/**
+ * @brief Проверява веднъж дали процесорът поддържа AVX2.
+ */
+static bool hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+/**
+ * Делението и сравнението с нула се правят за 4 имота наведнъж, а невалидните
+ * резултати се заменят с NaN чрез смесване по маската на сравнението.
+ */
+__attribute__((target("avx2")))
+static int pricePerSquareMetreAvx2(const double* prices, const double* totalAreas, int count, double* out) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d invalid = _mm256_set1_pd(numeric_limits<double>::quiet_NaN());
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d price = _mm256_loadu_pd(prices + i);
+        __m256d area = _mm256_loadu_pd(totalAreas + i);
+        __m256d valid = _mm256_cmp_pd(area, zero, _CMP_GT_OQ);
+        _mm256_storeu_pd(out + i, _mm256_blendv_pd(invalid, _mm256_div_pd(price, area), valid));
+    }
+    return i;
+}
+
+/**
+ * Средните стойности и допустимите отклонения на групите се събират с `gather` по ключовете
+ * на 4 реда, а абсолютната стойност се получава с изчистване на знаковия бит.
+ */
+__attribute__((target("avx2")))
+static int flagDeviationsAvx2(const double* values, const uint32_t* keys, const double* means, const double* limits,
+                              int count, unsigned char* flags, int& flagged) {
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i index = _mm_loadu_si128((const __m128i*)(keys + i));
+        __m256d mean = _mm256_mask_i32gather_pd(zero, means, index, all, 8);
+        __m256d limit = _mm256_mask_i32gather_pd(zero, limits, index, all, 8);
+        __m256d deviation = _mm256_andnot_pd(signMask, _mm256_sub_pd(_mm256_loadu_pd(values + i), mean));
+        int bits = _mm256_movemask_pd(_mm256_cmp_pd(deviation, limit, _CMP_GT_OQ));
+        flags[i] = bits & 1;
+        flags[i + 1] = (bits >> 1) & 1;
+        flags[i + 2] = (bits >> 2) & 1;
+        flags[i + 3] = (bits >> 3) & 1;
+        flagged += __builtin_popcount(bits);
+    }
+    return i;
+}
+
+static int pricePerSquareMetreSse2(const double* prices, const double* totalAreas, int count, double* out) {
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d invalid = _mm_set1_pd(numeric_limits<double>::quiet_NaN());
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128d price = _mm_loadu_pd(prices + i);
+        __m128d area = _mm_loadu_pd(totalAreas + i);
+        __m128d valid = _mm_cmpgt_pd(area, zero);
+        __m128d quotient = _mm_div_pd(price, area);
+        _mm_storeu_pd(out + i, _mm_or_pd(_mm_and_pd(valid, quotient), _mm_andnot_pd(valid, invalid)));
+    }
+    return i;
+}
+
+/**
+ * SSE2 няма `gather`, затова стойностите на групите за двата реда се зареждат поотделно.
+ */
+static int flagDeviationsSse2(const double* values, const uint32_t* keys, const double* means, const double* limits,
+                              int count, unsigned char* flags, int& flagged) {
+    const __m128d signMask = _mm_set1_pd(-0.0);
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128d mean = _mm_set_pd(means[keys[i + 1]], means[keys[i]]);
+        __m128d limit = _mm_set_pd(limits[keys[i + 1]], limits[keys[i]]);
+        __m128d deviation = _mm_andnot_pd(signMask, _mm_sub_pd(_mm_loadu_pd(values + i), mean));
+        int bits = _mm_movemask_pd(_mm_cmpgt_pd(deviation, limit));
+        flags[i] = bits & 1;
+        flags[i + 1] = (bits >> 1) & 1;
+        flagged += __builtin_popcount(bits);
+    }
+    return i;
+}
+
+#endif
+
+void computePricePerSquareMetre(const double* prices, const double* totalAreas, int count, double* out) {
+    int done = 0;
+#ifdef KERNELS_X86
+    done = hasAvx2() ? pricePerSquareMetreAvx2(prices, totalAreas, count, out)
+                     : pricePerSquareMetreSse2(prices, totalAreas, count, out);
+#endif
+    computePricePerSquareMetreScalar(prices + done, totalAreas + done, count - done, out + done);
+}
+
+int flagDeviations(const double* values, const uint32_t* keys, const double* means, const double* limits, int count,
+                   unsigned char* flags) {
+    int done = 0;
+    int flagged = 0;
+#ifdef KERNELS_X86
+    done = hasAvx2() ? flagDeviationsAvx2(values, keys, means, limits, count, flags, flagged)
+                     : flagDeviationsSse2(values, keys, means, limits, count, flags, flagged);
+#endif
+    return flagged + flagDeviationsScalar(values + done, keys + done, means, limits, count - done, flags + done);
+}
+
+const char* simdKernelName() {
+#ifdef KERNELS_X86
+    return hasAvx2() ? "avx2" : "sse2";
+#else
+    return "scalar";
+#endif
+}
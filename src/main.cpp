@@ -7,28 +7,45 @@
  * и след това влиза в цикъла на главното меню. Тя оркестрира цялостния поток на програмата.
  */
 
+#include <cstring>
+
 #include "structs.h"       
+#include "store.h"         
 #include "file.h"          
 #include "utils.h"         
 #include "menu.h"          
 #include "localization.h"  
+#include "batch.h"         
+#include "bench.h"         
 
 /**
  * @brief Входна точка на приложението "Система за управление на недвижими имоти".
  *
  * Тази функция изпълнява следните критични задачи при стартиране:
- * 1. Инициализира масив за съхранение на данни за имоти и задава първоначалния брой имоти на нула.
+ * 1. Инициализира празен контейнер `PropertyStore` за съхранение на данни за имоти.
  * 2. Зарежда преводите на езика по подразбиране (български) и след това позволява на потребителя да избере предпочитания от него език.
  * 3. Показва приветствения банер на приложението.
  * 4. Опитва се да зареди предварително запазени данни за имоти от текстов файл за синхронизация,
  *    възстановявайки състоянието на приложението от последната сесия.
  * 5. Влиза в цикъла на главното меню, позволявайки на потребителя да взаимодейства със системата.
  *
+ * При стартиране с `--exec <скрипт>` (или `--exec -` за стандартния вход) менютата се пропускат
+ * и командите от скрипта се изпълняват в пакетен режим чрез `runBatchScript`.
+ * При стартиране с `--bench <име> [брой]` се изпълнява сравнителен тест чрез `runBenchmark`.
+ *
+ * @param argc Броят на аргументите от командния ред.
+ * @param argv Аргументите от командния ред.
  * @return int Връща 0 при успешно изпълнение и прекратяване на програмата.
  */
-int main() {
-  Property properties[MAX_PROPERTIES]; 
-  int propertyCount = 0; 
+int main(int argc, char* argv[]) {
+  if (argc == 3 && strcmp(argv[1], "--exec") == 0) {
+    return runBatchScript(argv[2]);
+  }
+  if ((argc == 3 || argc == 4) && strcmp(argv[1], "--bench") == 0) {
+    return runBenchmark(argv[2], argc == 4 ? argv[3] : NULL);
+  }
+
+  PropertyStore store; 
 
   
   loadTranslations("bg");
@@ -41,11 +58,11 @@ int main() {
 
   
   
-  loadFromSyncTextFile(properties, propertyCount);
+  loadFromRecoveryFiles(store);
 
   
   
-  mainMenu(properties, propertyCount);
+  mainMenu(store);
 
   return 0; 
 }
\ No newline at end of file
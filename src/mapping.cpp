@@ -0,0 +1,66 @@
+/**
+ * @file mapping.cpp
+ * @brief Имплементация на проектирането на файлове в паметта, декларирано в `mapping.h`.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mapping.h"
+
+using namespace std;
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+/**
+ * Файловият дескриптор се затваря веднага след проектирането, тъй като проекцията
+ * остава валидна и без него. Ядрото се уведомява, че файлът ще се чете последователно.
+ */
+bool MappedFile::open(const char* path) {
+    close();
+
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    if (info.st_size > 0) {
+        void* address = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        madvise(address, (size_t)info.st_size, MADV_SEQUENTIAL);
+        mappedData = (const char*)address;
+        mappedSize = (size_t)info.st_size;
+    }
+
+    ::close(fd);
+    return true;
+}
+
+void MappedFile::close() {
+    if (mappedData != nullptr) {
+        munmap((void*)mappedData, mappedSize);
+        mappedData = nullptr;
+    }
+    mappedSize = 0;
+}
+
+const char* MappedFile::data() const {
+    return mappedData;
+}
+
+size_t MappedFile::size() const {
+    return mappedSize;
+}
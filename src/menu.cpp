@@ -20,6 +20,8 @@
 #include "display.h" 
 #include "delete.h"  
 #include "file.h"    
+#include "journal.h" 
+#include "import.h"  
 #include "reports.h" 
 #include "search.h"  
 #include "sort.h"    
@@ -38,10 +40,9 @@ using namespace std;
  * Цикълът се прекъсва само когато потребителят избере да излезе от приложението.
  * Преди излизане, тя гарантира, че текущите данни са запазени за възстановяване.
  *
- * @param properties Масив от структури `Property`, представляващ основния набор от данни.
- * @param propertyCount Референция към цяло число, съдържащо текущия брой имоти.
+ * @param store Контейнерът с имоти, представляващ основния набор от данни.
  */
-void mainMenu(Property properties[], int& propertyCount) {
+void mainMenu(PropertyStore& store) {
   while (true) {
     clearConsole(); 
     cout << CYAN << getTranslatedString("MAIN_MENU_TITLE") << RESET << endl;
@@ -61,17 +62,18 @@ void mainMenu(Property properties[], int& propertyCount) {
     switch (choice) {
       case 0:
         
-        saveToSyncTextFile(properties, propertyCount); 
+        syncDataToRecoveryFiles(store); 
+        closeJournal();
         cout << YELLOW << getTranslatedString("THANK_YOU_MESSAGE") << RESET << endl;
         exit(0); 
-      case 1: addPropertyMenu(properties, propertyCount); break;      
-      case 2: deletePropertyMenu(properties, propertyCount); break;   
-      case 3: displayMenu(properties, propertyCount); break;          
-      case 4: searchMenu(properties, propertyCount); break;           
-      case 5: sortMenu(properties, propertyCount); break;             
-      case 6: fileMenu(properties, propertyCount); break;             
-      case 7: updateProperty(properties, propertyCount); break;       
-      case 8: reportsMenu(properties, propertyCount); break;          
+      case 1: addPropertyMenu(store); break;      
+      case 2: deletePropertyMenu(store); break;   
+      case 3: displayMenu(store); break;          
+      case 4: searchMenu(store); break;           
+      case 5: sortMenu(store); break;             
+      case 6: fileMenu(store); break;             
+      case 7: updateProperty(store); break;       
+      case 8: reportsMenu(store); break;          
       default: cout << RED << getTranslatedString("INVALID_OPTION") << RESET << endl; break; 
     }
   }
@@ -85,10 +87,9 @@ void mainMenu(Property properties[], int& propertyCount) {
  * съответната функция (`addSingleProperty` или `addMultipleProperties`)
  * въз основа на валидирания избор на потребителя.
  *
- * @param properties Масив от структури `Property`, където ще бъдат добавени новите имоти.
- * @param propertyCount Референция към цяло число, съдържащо текущия брой имоти.
+ * @param store Контейнерът с имоти, в който ще бъдат добавени новите имоти.
  */
-void addPropertyMenu(Property properties[], int& propertyCount) {
+void addPropertyMenu(PropertyStore& store) {
   clearConsole();
   cout << CYAN << getTranslatedString("ADD_MENU_TITLE") << RESET << endl;
   cout << getTranslatedString("ADD_MENU_SINGLE_PROPERTY") << endl;
@@ -100,8 +101,8 @@ void addPropertyMenu(Property properties[], int& propertyCount) {
 
   switch (choice) {
     case 0: return; 
-    case 1: addSingleProperty(properties, propertyCount); break;   
-    case 2: addMultipleProperties(properties, propertyCount); break; 
+    case 1: addSingleProperty(store); break;   
+    case 2: addMultipleProperties(store); break; 
     default: cout << RED << getTranslatedString("INVALID_OPTION") << RESET << endl; break; 
   }
 }
@@ -113,10 +114,9 @@ void addPropertyMenu(Property properties[], int& propertyCount) {
  * или за изчистване на всички имоти от системата. То използва `getMenuChoice` за
  * валидиране на входа и извиква съответната функция за изтриване.
  *
- * @param properties Масив от структури `Property`, от които ще бъдат изтрити имоти.
- * @param propertyCount Референция към цяло число, съдържащо текущия брой имоти.
+ * @param store Контейнерът с имоти, от който ще бъдат изтрити имоти.
  */
-void deletePropertyMenu(Property properties[], int& propertyCount) {
+void deletePropertyMenu(PropertyStore& store) {
   clearConsole();
   cout << CYAN << getTranslatedString("DELETE_MENU_TITLE") << RESET << endl;
   cout << getTranslatedString("DELETE_MENU_SINGLE_PROPERTY") << endl;
@@ -128,8 +128,8 @@ void deletePropertyMenu(Property properties[], int& propertyCount) {
 
   switch (choice) {
     case 0: return; 
-    case 1: DeleteProperty(properties, propertyCount); break;   
-    case 2: DeleteAllProperties(properties, propertyCount); break; 
+    case 1: DeleteProperty(store); break;   
+    case 2: DeleteAllProperties(store); break; 
     default: cout << RED << getTranslatedString("INVALID_OPTION") << RESET << endl; break; 
   }
 }
@@ -141,10 +141,9 @@ void deletePropertyMenu(Property properties[], int& propertyCount) {
  * или имоти с най-голяма обща площ. То извиква съответната функция за показване
  * въз основа на валидирания вход на потребителя.
  *
- * @param properties Постоянен масив от структури `Property` за показване.
- * @param propertyCount Текущият брой имоти в системата.
+ * @param store Контейнерът с имоти за показване.
  */
-void displayMenu(const Property properties[], int propertyCount) {
+void displayMenu(const PropertyStore& store) {
   clearConsole();
   cout << CYAN << getTranslatedString("DISPLAY_MENU_TITLE") << RESET << endl;
   cout << getTranslatedString("DISPLAY_MENU_ALL_PROPERTIES") << endl;
@@ -157,9 +156,9 @@ void displayMenu(const Property properties[], int propertyCount) {
 
   switch (choice) {
     case 0: return; 
-    case 1: displayAllProperties(properties, propertyCount); break;   
-    case 2: displaySoldProperties(properties, propertyCount); break; 
-    case 3: displayLargestProperties(properties, propertyCount); break; 
+    case 1: displayAllProperties(store); break;   
+    case 2: displaySoldProperties(store); break; 
+    case 3: displayLargestProperties(store); break; 
     default: cout << RED << getTranslatedString("INVALID_OPTION") << RESET << endl; break; 
   }
 }
@@ -171,60 +170,122 @@ void displayMenu(const Property properties[], int propertyCount) {
  * по брой стаи. То извиква съответната функция за търсене въз основа
  * на валидирания избор на потребителя.
  *
- * @param properties Постоянен масив от структури `Property` за търсене.
- * @param propertyCount Текущият брой имоти в системата.
+ * @param store Контейнерът с имоти за търсене.
  */
-void searchMenu(Property properties[], int propertyCount) {
+void searchMenu(const PropertyStore& store) {
   clearConsole();
   cout << CYAN << getTranslatedString("SEARCH_MENU_TITLE") << RESET << endl;
   cout << getTranslatedString("SEARCH_MENU_BY_BROKER") << endl;
   cout << getTranslatedString("SEARCH_MENU_BY_ROOMS") << endl;
+  cout << getTranslatedString("SEARCH_MENU_BY_RANGES") << endl;
   cout << getTranslatedString("ADD_MENU_BACK") << endl; 
 
   
-  int choice = getMenuChoice(0, 2);
+  int choice = getMenuChoice(0, 3);
 
   switch (choice) {
     case 0: return; 
-    case 1: searchByBroker(properties, propertyCount); break;   
-    case 2: searchByRooms(properties, propertyCount); break;    
+    case 1: searchByBroker(store); break;   
+    case 2: searchByRooms(store); break;    
+    case 3: searchByRanges(store); break;   
     default: cout << RED << getTranslatedString("INVALID_OPTION") << RESET << endl; break; 
   }
 }
 
+/**
+ * @brief Ключове за превод на имената на полетата за сортиране, по реда на `SortField`.
+ */
+static const char* const SORT_FIELD_KEYS[SORT_FIELD_COUNT] = {
+    "REF_SHORT", "BROKER_SHORT", "TYPE_SHORT", "AREA_SHORT", "EXPOSITION_SHORT", "PRICE_SHORT",
+    "SORT_FIELD_TOTAL_AREA", "ROOMS_SHORT", "FLOOR_SHORT", "STATUS_SHORT"
+};
+
+/**
+ * @brief Сортира целия каталог по няколко полета, избрани от потребителя.
+ *
+ * Полетата се избират едно по едно по приоритет (до `MAX_SORT_CRITERIA`, повторен избор
+ * се пропуска), като за всяко се избира и посока. Накрая потребителят избира дали имотите,
+ * равни по всички полета, да запазят реда си в каталога (стабилно сортиране).
+ *
+ * @param store Контейнерът с имоти за сортиране.
+ */
+static void sortAllByFields(PropertyStore& store) {
+  cout << CYAN << getTranslatedString("SORT_FIELDS_TITLE") << RESET << endl;
+  for (int i = 0; i < SORT_FIELD_COUNT; i++) {
+    cout << "  " << i + 1 << ". " << getTranslatedString(SORT_FIELD_KEYS[i]) << endl;
+  }
+
+  vector<SortCriterion> criteria;
+  while ((int)criteria.size() < MAX_SORT_CRITERIA) {
+    int choice = getMenuChoice(0, SORT_FIELD_COUNT);
+    if (choice == -1) {
+      cout << RED << getTranslatedString("INVALID_OPTION") << RESET << endl;
+      continue;
+    }
+    if (choice == 0) break;
+
+    SortCriterion criterion = {(SortField)(choice - 1), true};
+    bool repeated = false;
+    for (const SortCriterion& chosen : criteria) {
+      repeated = repeated || chosen.field == criterion.field;
+    }
+    if (repeated) continue;
+
+    cout << getTranslatedString("SORT_ORDER_ASCENDING") << endl;
+    cout << getTranslatedString("SORT_ORDER_DESCENDING") << endl;
+    while (true) {
+      int order = getValidNumericInput<int>((CYAN + getTranslatedString("ENTER_YOUR_CHOICE") + RESET).c_str());
+      if (order == 1 || order == 2) {
+        criterion.ascending = order == 1;
+        break;
+      }
+      cout << RED << getTranslatedString("ERROR_INVALID_SORT_CHOICE") << RESET << endl;
+    }
+    criteria.push_back(criterion);
+    cout << CYAN << getTranslatedString("SORT_FIELDS_NEXT") << RESET << endl;
+  }
+  if (criteria.empty()) return;
+
+  bool stable = getConfirmation(getTranslatedString("PROMPT_SORT_STABLE").c_str());
+  store.sortByFields(criteria, stable);
+  syncDataToRecoveryFiles(store);
+  cout << GREEN << getTranslatedString("SORT_BY_FIELDS_SUCCESS") << RESET << endl;
+}
+
 /**
  * @brief Показва менюто за сортиране на имоти и обработва изборите на потребителя.
  *
  * Това подменю предоставя опции за сортиране на имоти въз основа на различни критерии.
- * Текущата имплементация позволява сортиране по цена за конкретни резултати от търсене
- * или сортиране на целия масив от имоти по цена във възходящ ред.
+ * Текущата имплементация позволява сортиране по цена за конкретни резултати от търсене,
+ * сортиране на целия масив от имоти по цена във възходящ ред или по няколко избрани полета.
  *
- * @param properties Масив от структури `Property` за сортиране.
- * @param propertyCount Текущият брой имоти в системата.
+ * @param store Контейнерът с имоти за сортиране.
  */
-void sortMenu(Property properties[], int propertyCount) {
+void sortMenu(PropertyStore& store) {
   clearConsole();
   cout << CYAN << getTranslatedString("SORT_MENU_TITLE") << RESET << endl;
   cout << getTranslatedString("SORT_MENU_BROKER_PRICE") << endl;
   cout << getTranslatedString("SORT_MENU_ROOMS_PRICE") << endl;
   cout << getTranslatedString("SORT_MENU_ALL_PRICE_ASC") << endl;
+  cout << getTranslatedString("SORT_MENU_ALL_BY_FIELDS") << endl;
   cout << getTranslatedString("ADD_MENU_BACK") << endl; 
 
   
-  int choice = getMenuChoice(0, 3);
+  int choice = getMenuChoice(0, 4);
 
   switch (choice) {
     case 0: return; 
     
     
-    case 1: searchByBroker(properties, propertyCount); break; 
-    case 2: searchByRooms(properties, propertyCount); break; 
+    case 1: searchByBroker(store); break; 
+    case 2: searchByRooms(store); break; 
     case 3:
         
-        sortPropertiesArray(properties, propertyCount, true);
-        syncDataToRecoveryFiles(properties, propertyCount); 
+        store.sortByPrice(true);
+        syncDataToRecoveryFiles(store); 
         cout << GREEN << getTranslatedString("SORT_ALL_PROPERTIES_SUCCESS") << RESET << endl;
         break;
+    case 4: sortAllByFields(store); break;
     default: cout << RED << getTranslatedString("INVALID_OPTION") << RESET << endl; break; 
   }
 }
@@ -233,28 +294,30 @@ void sortMenu(Property properties[], int propertyCount) {
  * @brief Показва менюто за файлови операции (запис/зареждане) и обработва изборите на потребителя.
  *
  * Това подменю предоставя опции за записване на данни за имоти в двоичен файл,
- * зареждане на данни от двоичен файл или записване на данни в удобен за потребителя текстов файл за отчет.
+ * зареждане на данни от двоичен файл, записване на данни в удобен за потребителя текстов файл за отчет
+ * или масово импортиране на обяви от CSV файл или файл, разделен с | (pipe).
  * То извиква съответната функция за обработка на файлове въз основа на валидирания вход на потребителя.
  *
- * @param properties Масив от структури `Property` за файлови операции.
- * @param propertyCount Референция към цяло число, съдържащо текущия брой имоти.
+ * @param store Контейнерът с имоти за файлови операции.
  */
-void fileMenu(Property properties[], int& propertyCount) {
+void fileMenu(PropertyStore& store) {
   clearConsole();
   cout << CYAN << getTranslatedString("FILE_MENU_TITLE") << RESET << endl;
   cout << getTranslatedString("FILE_MENU_SAVE_BINARY") << endl;
   cout << getTranslatedString("FILE_MENU_LOAD_BINARY") << endl;
   cout << getTranslatedString("FILE_MENU_SAVE_TEXT") << endl;
+  cout << getTranslatedString("FILE_MENU_IMPORT") << endl;
   cout << getTranslatedString("ADD_MENU_BACK") << endl; 
 
   
-  int choice = getMenuChoice(0, 3);
+  int choice = getMenuChoice(0, 4);
 
   switch (choice) {
     case 0: return; 
-    case 1: saveToBinaryFile(properties, propertyCount); break;           
-    case 2: loadFromBinaryFile(properties, propertyCount); break;         
-    case 3: saveToUserFriendlyTextFile(properties, propertyCount); break; 
+    case 1: saveToBinaryFile(store); break;           
+    case 2: loadFromBinaryFile(store); syncDataToRecoveryFiles(store); break; 
+    case 3: saveToUserFriendlyTextFile(store); break; 
+    case 4: importPropertiesFromFile(store); break;   
     default: cout << RED << getTranslatedString("INVALID_OPTION") << RESET << endl; break; 
   }
 }
@@ -267,25 +330,40 @@ void fileMenu(Property properties[], int& propertyCount) {
  * средната цена в район или определяне на процентите на продадени от брокер.
  * То извиква съответната функция за генериране на отчети.
  *
- * @param properties Постоянен масив от структури `Property` за генериране на отчети.
- * @param propertyCount Текущият брой имоти в системата.
+ * @param store Контейнерът с имоти за генериране на отчети.
  */
-void reportsMenu(const Property properties[], int propertyCount) {
+void reportsMenu(const PropertyStore& store) {
   clearConsole();
   cout << CYAN << getTranslatedString("REPORTS_MENU_TITLE") << RESET << endl;
   cout << getTranslatedString("REPORTS_MENU_MOST_EXPENSIVE_IN_AREA") << endl;
   cout << getTranslatedString("REPORTS_MENU_AVERAGE_PRICE_IN_AREA") << endl;
   cout << getTranslatedString("REPORTS_MENU_SOLD_PERCENTAGE_PER_BROKER") << endl;
+  cout << getTranslatedString("REPORTS_MENU_TOP_EXPENSIVE_IN_AREA") << endl;
+  cout << getTranslatedString("REPORTS_MENU_TOP_LARGEST") << endl;
+  cout << getTranslatedString("REPORTS_MENU_TOP_CHEAPEST_PER_SQ_M") << endl;
+  cout << getTranslatedString("REPORTS_MENU_GROUP_REPORT") << endl;
+  cout << getTranslatedString("REPORTS_MENU_PRICE_PERCENTILES") << endl;
+  cout << getTranslatedString("REPORTS_MENU_PRICE_PER_SQ_M") << endl;
+  cout << getTranslatedString("REPORTS_MENU_PRICE_PER_SQ_M_OUTLIERS") << endl;
+  cout << getTranslatedString("REPORTS_MENU_ALL_AREAS") << endl;
   cout << getTranslatedString("ADD_MENU_BACK") << endl; 
 
   
-  int choice = getMenuChoice(0, 3);
+  int choice = getMenuChoice(0, 11);
 
   switch (choice) {
     case 0: return; 
-    case 1: mostExpensiveInArea(properties, propertyCount); break;         
-    case 2: averagePriceInArea(properties, propertyCount); break;           
-    case 3: soldPercentagePerBroker(properties, propertyCount); break;     
+    case 1: mostExpensiveInArea(store); break;         
+    case 2: averagePriceInArea(store); break;           
+    case 3: soldPercentagePerBroker(store); break;     
+    case 4: topExpensiveInArea(store); break;
+    case 5: topLargestProperties(store); break;
+    case 6: topCheapestPerSquareMetre(store); break;
+    case 7: customGroupReport(store); break;
+    case 8: pricePercentiles(store); break;
+    case 9: pricePerSquareMetreReport(store); break;
+    case 10: pricePerSquareMetreOutliers(store); break;
+    case 11: allAreasReport(store); break;
     default: cout << RED << getTranslatedString("INVALID_OPTION") << RESET << endl; break; 
   }
 }
\ No newline at end of file
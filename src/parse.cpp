@@ -0,0 +1,187 @@
+/**
+ * @file parse.cpp
+ * @brief Имплементация на разчитането на формата на `sync.txt`, декларирано в `parse.h`.
+ *
+ * Текстът се обхожда директно в паметта (обикновено проектиран файл), като редовете
+ * и полетата се откриват чрез `memchr`. Последователното разчитане добавя всеки имот
+ * в контейнера веднага след разчитането на реда му, без междинен масив.
+ */
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "parse.h"
+
+using namespace std;
+
+/**
+ * @brief Прочита текстово поле до следващия разделител | и премества курсора след него.
+ */
+static bool parseTextField(const char*& cursor, const char* end, char* destination, size_t size) {
+    const char* separator = (const char*)memchr(cursor, '|', end - cursor);
+    if (separator == NULL || separator == cursor) {
+        return false;
+    }
+    size_t length = min((size_t)(separator - cursor), size - 1);
+    memcpy(destination, cursor, length);
+    destination[length] = '\0';
+    cursor = separator + 1;
+    return true;
+}
+
+/**
+ * @brief Прочита числово поле и, ако не е последно в реда, разделителя | след него.
+ */
+template <typename T>
+static bool parseNumberField(const char*& cursor, const char* end, T& value, bool lastField = false) {
+    from_chars_result result = from_chars(cursor, end, value);
+    if (result.ec != errc()) {
+        return false;
+    }
+    cursor = result.ptr;
+    if (lastField) {
+        return true;
+    }
+    if (cursor == end || *cursor != '|') {
+        return false;
+    }
+    cursor++;
+    return true;
+}
+
+bool parseSyncFields(const char* begin, const char* end, Property& property) {
+    const char* cursor = begin;
+    int statusInt;
+
+    if (!parseNumberField(cursor, end, property.refNumber)) return false;
+    if (!parseTextField(cursor, end, property.broker, sizeof(property.broker))) return false;
+    if (!parseTextField(cursor, end, property.type, sizeof(property.type))) return false;
+    if (!parseTextField(cursor, end, property.area, sizeof(property.area))) return false;
+    if (!parseTextField(cursor, end, property.exposition, sizeof(property.exposition))) return false;
+    if (!parseNumberField(cursor, end, property.price)) return false;
+    if (!parseNumberField(cursor, end, property.totalArea)) return false;
+    if (!parseNumberField(cursor, end, property.rooms)) return false;
+    if (!parseNumberField(cursor, end, property.floor)) return false;
+    if (!parseNumberField(cursor, end, statusInt, true)) return false;
+
+    if (statusInt >= SOLD && statusInt <= AVAILABLE) {
+        property.status = (Status)statusInt;
+    } else {
+        property.status = AVAILABLE;
+    }
+    return true;
+}
+
+bool parseSyncRecord(const char* begin, const char* end, Property& property) {
+    return parseSyncFields(begin, end, property) && isfinite(property.price) && isfinite(property.totalArea);
+}
+
+/**
+ * @brief Разчита всички редове в интервала и подава всеки имот на `consume`.
+ *
+ * Празните редове се пропускат.
+ *
+ * @return `true`, ако всички редове са валидни; `false`, ако разчитането е спряло на невалиден ред.
+ */
+template <typename Consumer>
+static bool parseLines(const char* begin, const char* end, Consumer consume) {
+    Property property;
+    const char* line = begin;
+    while (line < end) {
+        const char* newline = (const char*)memchr(line, '\n', end - line);
+        const char* lineEnd = newline != NULL ? newline : end;
+        const char* next = newline != NULL ? newline + 1 : end;
+
+        if (lineEnd > line && lineEnd[-1] == '\r') {
+            lineEnd--;
+        }
+        if (lineEnd > line) {
+            if (!parseSyncRecord(line, lineEnd, property)) {
+                return false;
+            }
+            consume(property);
+        }
+        line = next;
+    }
+    return true;
+}
+
+/**
+ * @brief Резултат от разчитането на една част от текста в паралелния режим.
+ */
+struct ParsedChunk {
+    vector<Property> properties;
+    bool complete = true;
+};
+
+/**
+ * В паралелния режим контейнерът не може да се попълва едновременно от няколко нишки,
+ * затова всяка нишка разчита своята част в отделен масив, а масивите се добавят
+ * в контейнера последователно. Ако в някоя част има невалиден ред, следващите части
+ * се отхвърлят, за да съвпада резултатът с последователното разчитане.
+ */
+int parseSyncText(const char* data, size_t size, PropertyStore& store, int threadCount) {
+    if (data == NULL || size == 0) {
+        return 0;
+    }
+
+    if (threadCount <= 0) {
+        threadCount = 1;
+        if (size >= PARALLEL_PARSE_THRESHOLD) {
+            threadCount = max(1, (int)thread::hardware_concurrency());
+        }
+    }
+
+    const char* end = data + size;
+    int initialSize = store.size();
+
+    if (threadCount == 1) {
+        parseLines(data, end, [&store](const Property& property) { store.append(property); });
+        store.finishAppend();
+        return store.size() - initialSize;
+    }
+
+    vector<const char*> boundaries;
+    boundaries.push_back(data);
+    for (int i = 1; i < threadCount; i++) {
+        const char* split = max(data + size / threadCount * i, boundaries.back());
+        const char* newline = (const char*)memchr(split, '\n', end - split);
+        boundaries.push_back(newline != NULL ? newline + 1 : end);
+    }
+    boundaries.push_back(end);
+
+    vector<ParsedChunk> chunks(threadCount);
+    vector<thread> workers;
+    for (int i = 0; i < threadCount; i++) {
+        workers.emplace_back([&chunks, &boundaries, i]() {
+            ParsedChunk& chunk = chunks[i];
+            chunk.properties.reserve((boundaries[i + 1] - boundaries[i]) / 64);
+            chunk.complete = parseLines(boundaries[i], boundaries[i + 1],
+                                        [&chunk](const Property& property) { chunk.properties.push_back(property); });
+        });
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    size_t total = 0;
+    for (const ParsedChunk& chunk : chunks) {
+        total += chunk.properties.size();
+    }
+    store.reserve(initialSize + (int)total);
+
+    for (const ParsedChunk& chunk : chunks) {
+        for (const Property& property : chunk.properties) {
+            store.append(property);
+        }
+        if (!chunk.complete) {
+            break;
+        }
+    }
+    store.finishAppend();
+    return store.size() - initialSize;
+}
@@ -0,0 +1,408 @@
+/**
+ * @file query.cpp
+ * @brief Имплементация на съставните заявки и битовите маски, декларирани в `query.h`.
+ *
+ * Преди изпълнение дървото на заявката се превежда в плосък списък от възли с готови
+ * указатели към колоните и идентификатори от речниците. След това за всеки блок от редове
+ * възлите се изчисляват рекурсивно в локални маски, а резултатът се записва в `Selection`.
+ * Когато резултатът е нужен подреден по цена, кандидатите се вземат от индексите
+ * на контейнера и за всеки от тях възлите се проверяват поотделно.
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include "query.h"
+#include "sort.h"
+
+using namespace std;
+
+const int BLOCK_WORDS = QUERY_BLOCK_ROWS / 64;
+
+Selection::Selection(int size) : words((size + 63) / 64, 0), rows(size) {
+}
+
+int Selection::size() const {
+    return rows;
+}
+
+int Selection::count() const {
+    int total = 0;
+    for (uint64_t word : words) {
+        total += __builtin_popcountll(word);
+    }
+    return total;
+}
+
+bool Selection::test(int slot) const {
+    return (words[slot / 64] >> (slot % 64)) & 1;
+}
+
+vector<uint32_t> Selection::slots() const {
+    vector<uint32_t> result;
+    result.reserve(count());
+    forEach([&result](uint32_t slot) { result.push_back(slot); });
+    return result;
+}
+
+/**
+ * @brief Възел на заявка, подготвен за изпълнение върху конкретен контейнер.
+ */
+struct Query::CompiledNode {
+    Kind kind;
+    Field field;
+    bool matchesNothing;
+    uint32_t id;
+    double low;
+    double high;
+    const uint32_t* idColumn;
+    const unsigned char* statusColumn;
+    const int* intColumn;
+    const double* doubleColumn;
+    vector<int> children;
+};
+
+Query::Query(Kind kind, Field field) : kind(kind), field(field), low(0), high(0) {
+}
+
+Query Query::all() {
+    return Query(KIND_ALL, FIELD_BROKER);
+}
+
+Query Query::text(Field field, const string& value) {
+    Query query(KIND_TEXT, field);
+    query.value = value;
+    return query;
+}
+
+Query Query::range(Field field, double low, double high) {
+    Query query(KIND_RANGE, field);
+    query.low = low;
+    query.high = high;
+    return query;
+}
+
+Query Query::broker(const string& name) { return text(FIELD_BROKER, name); }
+Query Query::area(const string& name) { return text(FIELD_AREA, name); }
+Query Query::type(const string& name) { return text(FIELD_TYPE, name); }
+Query Query::exposition(const string& name) { return text(FIELD_EXPOSITION, name); }
+Query Query::status(Status status) { return range(FIELD_STATUS, status, status); }
+Query Query::rooms(double low, double high) { return range(FIELD_ROOMS, low, high); }
+Query Query::floor(double low, double high) { return range(FIELD_FLOOR, low, high); }
+Query Query::price(double low, double high) { return range(FIELD_PRICE, low, high); }
+Query Query::totalArea(double low, double high) { return range(FIELD_TOTAL_AREA, low, high); }
+
+/**
+ * Вложените И (съответно ИЛИ) се сливат в един възел с повече деца.
+ */
+Query Query::operator&&(const Query& other) const {
+    Query query(KIND_AND, FIELD_BROKER);
+    for (const Query* part : {this, &other}) {
+        if (part->kind == KIND_AND) {
+            query.children.insert(query.children.end(), part->children.begin(), part->children.end());
+        } else {
+            query.children.push_back(*part);
+        }
+    }
+    return query;
+}
+
+Query Query::operator||(const Query& other) const {
+    Query query(KIND_OR, FIELD_BROKER);
+    for (const Query* part : {this, &other}) {
+        if (part->kind == KIND_OR) {
+            query.children.insert(query.children.end(), part->children.begin(), part->children.end());
+        } else {
+            query.children.push_back(*part);
+        }
+    }
+    return query;
+}
+
+/**
+ * @brief Добавя възела и децата му в `nodes` и връща индекса му.
+ */
+int Query::compile(const PropertyStore& store, vector<CompiledNode>& nodes) const {
+    CompiledNode node = {};
+    node.kind = kind;
+    node.field = field;
+    node.low = low;
+    node.high = high;
+
+    if (kind == KIND_TEXT) {
+        const StringDictionary* dictionary = &store.brokers();
+        node.idColumn = store.brokerIds();
+        if (field == FIELD_TYPE) { dictionary = &store.types(); node.idColumn = store.typeIds(); }
+        if (field == FIELD_AREA) { dictionary = &store.areas(); node.idColumn = store.areaIds(); }
+        if (field == FIELD_EXPOSITION) { dictionary = &store.expositions(); node.idColumn = store.expositionIds(); }
+        int64_t id = dictionary->find(value.c_str());
+        node.matchesNothing = id == -1;
+        node.id = id == -1 ? 0 : (uint32_t)id;
+    } else if (kind == KIND_RANGE) {
+        node.matchesNothing = !(low <= high);
+        switch (field) {
+            case FIELD_STATUS: node.statusColumn = store.statuses(); break;
+            case FIELD_ROOMS: node.intColumn = store.rooms(); break;
+            case FIELD_FLOOR: node.intColumn = store.floors(); break;
+            case FIELD_PRICE: node.doubleColumn = store.prices(); break;
+            default: node.doubleColumn = store.totalAreas(); break;
+        }
+    }
+
+    int index = (int)nodes.size();
+    nodes.push_back(node);
+    for (const Query& child : children) {
+        int childIndex = child.compile(store, nodes);
+        nodes[index].children.push_back(childIndex);
+    }
+    return index;
+}
+
+/**
+ * @brief Попълва маските за редовете `[begin, begin + count)`, за които `matches(i)` е вярно.
+ *
+ * Вътрешният цикъл е с фиксирана дължина 64 и без разклонения, за да може да бъде векторизиран.
+ */
+template <typename Matches>
+static void fillMask(int begin, int count, uint64_t* mask, Matches matches) {
+    int fullWords = count / 64;
+    for (int word = 0; word < fullWords; word++) {
+        int base = begin + word * 64;
+        uint64_t bits = 0;
+        for (int bit = 0; bit < 64; bit++) {
+            bits |= (uint64_t)matches(base + bit) << bit;
+        }
+        mask[word] = bits;
+    }
+    int tail = count % 64;
+    if (tail > 0) {
+        int base = begin + fullWords * 64;
+        uint64_t bits = 0;
+        for (int bit = 0; bit < tail; bit++) {
+            bits |= (uint64_t)matches(base + bit) << bit;
+        }
+        mask[fullWords] = bits;
+    }
+}
+
+/**
+ * @brief Изчислява възел `index` за блока `[begin, begin + count)` и записва резултата в `mask`.
+ *
+ * При И обработката спира, щом маската стане празна, а при ИЛИ - щом стане пълна.
+ */
+void Query::evaluateBlock(const vector<CompiledNode>& nodes, int index, int begin, int count, uint64_t* mask) {
+    const CompiledNode& node = nodes[index];
+    int wordCount = (count + 63) / 64;
+    uint64_t lastWord = count % 64 == 0 ? ~(uint64_t)0 : ((uint64_t)1 << (count % 64)) - 1;
+
+    if (node.kind == KIND_ALL) {
+        fill(mask, mask + wordCount, ~(uint64_t)0);
+        mask[wordCount - 1] = lastWord;
+        return;
+    }
+    if (node.matchesNothing) {
+        fill(mask, mask + wordCount, (uint64_t)0);
+        return;
+    }
+
+    if (node.kind == KIND_AND || node.kind == KIND_OR) {
+        bool isAnd = node.kind == KIND_AND;
+        uint64_t childMask[BLOCK_WORDS];
+        evaluateBlock(nodes, node.children[0], begin, count, mask);
+        for (size_t child = 1; child < node.children.size(); child++) {
+            uint64_t combined = 0;
+            uint64_t full = ~(uint64_t)0;
+            for (int word = 0; word < wordCount; word++) {
+                combined |= mask[word];
+                full &= word == wordCount - 1 ? (mask[word] | ~lastWord) : mask[word];
+            }
+            if (isAnd ? combined == 0 : full == ~(uint64_t)0) {
+                return;
+            }
+
+            evaluateBlock(nodes, node.children[child], begin, count, childMask);
+            for (int word = 0; word < wordCount; word++) {
+                mask[word] = isAnd ? (mask[word] & childMask[word]) : (mask[word] | childMask[word]);
+            }
+        }
+        return;
+    }
+
+    if (node.kind == KIND_TEXT) {
+        const uint32_t* column = node.idColumn;
+        uint32_t id = node.id;
+        fillMask(begin, count, mask, [column, id](int i) { return column[i] == id; });
+    } else if (node.statusColumn != NULL) {
+        const unsigned char* column = node.statusColumn;
+        double low = node.low;
+        double high = node.high;
+        fillMask(begin, count, mask, [column, low, high](int i) { return (low <= column[i]) & (column[i] <= high); });
+    } else if (node.intColumn != NULL) {
+        const int* column = node.intColumn;
+        double low = node.low;
+        double high = node.high;
+        fillMask(begin, count, mask, [column, low, high](int i) { return (low <= column[i]) & (column[i] <= high); });
+    } else {
+        const double* column = node.doubleColumn;
+        double low = node.low;
+        double high = node.high;
+        fillMask(begin, count, mask, [column, low, high](int i) { return (low <= column[i]) & (column[i] <= high); });
+    }
+}
+
+Selection Query::evaluate(const PropertyStore& store) const {
+    Selection selection(store.size());
+    if (store.empty()) {
+        return selection;
+    }
+
+    vector<CompiledNode> nodes;
+    compile(store, nodes);
+
+    for (int begin = 0; begin < store.size(); begin += QUERY_BLOCK_ROWS) {
+        int count = min(QUERY_BLOCK_ROWS, store.size() - begin);
+        evaluateBlock(nodes, 0, begin, count, &selection.words[begin / 64]);
+    }
+    return selection;
+}
+
+vector<uint32_t> Query::findSlots(const PropertyStore& store) const {
+    return evaluate(store).slots();
+}
+
+/**
+ * @brief Проверява дали имотът на позиция `slot` отговаря на възел `index`.
+ */
+bool Query::matchesSlot(const vector<CompiledNode>& nodes, int index, uint32_t slot) {
+    const CompiledNode& node = nodes[index];
+    if (node.kind == KIND_ALL) {
+        return true;
+    }
+    if (node.matchesNothing) {
+        return false;
+    }
+    if (node.kind == KIND_AND || node.kind == KIND_OR) {
+        bool isAnd = node.kind == KIND_AND;
+        for (int child : node.children) {
+            if (matchesSlot(nodes, child, slot) != isAnd) {
+                return !isAnd;
+            }
+        }
+        return isAnd;
+    }
+    if (node.kind == KIND_TEXT) {
+        return node.idColumn[slot] == node.id;
+    }
+
+    double value;
+    if (node.statusColumn != NULL) value = node.statusColumn[slot];
+    else if (node.intColumn != NULL) value = node.intColumn[slot];
+    else value = node.doubleColumn[slot];
+    return node.low <= value && value <= node.high;
+}
+
+/**
+ * @brief Връща броя на имотите, които индексът на контейнера дава за това условие,
+ * или `SIZE_MAX`, ако за условието няма индекс.
+ */
+size_t Query::indexedCount(const PropertyStore& store) const {
+    if (kind == KIND_ALL) {
+        return store.size();
+    }
+    if (kind == KIND_TEXT && field == FIELD_BROKER) {
+        int64_t brokerId = store.brokers().find(value.c_str());
+        return brokerId == -1 ? 0 : store.countByBroker((uint32_t)brokerId);
+    }
+    if (kind != KIND_RANGE || field == FIELD_STATUS) {
+        return SIZE_MAX;
+    }
+    if (!(low <= high)) {
+        return 0;
+    }
+    switch (field) {
+        case FIELD_PRICE: return store.countInRange(RANGE_PRICE, low, high);
+        case FIELD_TOTAL_AREA: return store.countInRange(RANGE_TOTAL_AREA, low, high);
+        case FIELD_FLOOR: return store.countInRange(RANGE_FLOOR, low, high);
+        default: return store.countInRange(RANGE_ROOMS, low, high);
+    }
+}
+
+/**
+ * @brief Взема от индекса на контейнера позициите за условие, за което `indexedCount` не е `SIZE_MAX`.
+ * @param ordered Получава `true`, ако позициите вече са подредени по цена в поискания ред.
+ *
+ * Индексите по брокер и по брой стаи са подредени по цена в двете посоки, а индексът
+ * по цена - във възходящ ред.
+ */
+vector<uint32_t> Query::indexedSlots(const PropertyStore& store, bool sortAscending, bool& ordered) const {
+    ordered = sortAscending;
+    if (kind == KIND_ALL) {
+        return store.findInRange(RANGE_PRICE, -numeric_limits<double>::infinity(), numeric_limits<double>::infinity());
+    }
+    if (kind == KIND_TEXT) {
+        ordered = true;
+        int64_t brokerId = store.brokers().find(value.c_str());
+        return brokerId == -1 ? vector<uint32_t>() : store.findByBroker((uint32_t)brokerId, sortAscending);
+    }
+    if (!(low <= high)) {
+        ordered = true;
+        return vector<uint32_t>();
+    }
+    switch (field) {
+        case FIELD_PRICE:
+            return store.findInRange(RANGE_PRICE, low, high);
+        case FIELD_TOTAL_AREA:
+            ordered = false;
+            return store.findInRange(RANGE_TOTAL_AREA, low, high);
+        case FIELD_FLOOR:
+            ordered = false;
+            return store.findInRange(RANGE_FLOOR, low, high);
+        default:
+            if (low == high && low == (int)low) {
+                ordered = true;
+                return store.findByRooms((int)low, sortAscending);
+            }
+            ordered = false;
+            return store.findInRange(RANGE_ROOMS, low, high);
+    }
+}
+
+vector<uint32_t> Query::findSlotsByPrice(const PropertyStore& store, bool sortAscending) const {
+    const Query* driver = NULL;
+    size_t driverCount = SIZE_MAX;
+    auto consider = [&](const Query& part) {
+        size_t count = part.indexedCount(store);
+        if (count < driverCount) {
+            driver = &part;
+            driverCount = count;
+        }
+    };
+    if (kind == KIND_AND) {
+        for (const Query& child : children) {
+            consider(child);
+        }
+    } else {
+        consider(*this);
+    }
+
+    if (driver == NULL) {
+        vector<uint32_t> slots = findSlots(store);
+        sortSlotsByPrice(store, slots, sortAscending);
+        return slots;
+    }
+
+    bool ordered;
+    vector<uint32_t> slots = driver->indexedSlots(store, sortAscending, ordered);
+    if (driver != this) {
+        vector<CompiledNode> nodes;
+        compile(store, nodes);
+        slots.erase(remove_if(slots.begin(), slots.end(),
+                              [&nodes](uint32_t slot) { return !matchesSlot(nodes, 0, slot); }),
+                    slots.end());
+    }
+    if (!ordered) {
+        sort(slots.begin(), slots.end());
+        sortSlotsByPrice(store, slots, sortAscending);
+    }
+    return slots;
+}
@@ -11,30 +11,39 @@
 #include <iostream>    
 #include <cstring>     
 #include <iomanip>     
-#include <map>         
+#include <vector>      
+#include <algorithm>   
+#include <cmath>
+#include <limits>
 
 #include "reports.h"   
 #include "structs.h"   
+#include "store.h"     
+#include "sort.h"      
+#include "group.h"     
+#include "aggregate.h" 
+#include "kernels.h"
+#include "utils.h"     
 #include "display.h"   
 #include "colors.h"    
 #include "add.h"       
 #include "localization.h" 
+#include "file.h"
 
 using namespace std;
 
 /**
  * @brief Намира и показва най-скъпия имот в указан от потребителя район.
  *
- * Тази функция подканва потребителя да въведе конкретен район. След това тя итерира
- * през масива от имоти, за да намери този с най-висока цена,
- * който съвпада с посочения район. Ако не бъдат намерени имоти в района
+ * Тази функция подканва потребителя да въведе конкретен район и взема имота с най-висока
+ * цена в него от обобщените стойности по райони, които контейнерът поддържа при всяка
+ * промяна. Ако не бъдат намерени имоти в района
  * или ако в системата не съществуват имоти, се показват подходящи съобщения.
  *
- * @param properties Постоянен масив от структури `Property` за анализ.
- * @param propertyCount Броят на валидните имоти в масива.
+ * @param store Контейнерът с имоти за анализ.
  */
-void mostExpensiveInArea(const Property properties[], int propertyCount) {
-    if (propertyCount == 0) {
+void mostExpensiveInArea(const PropertyStore& store) {
+    if (store.empty()) {
         cout << YELLOW << getTranslatedString("NO_PROPERTIES_IN_SYSTEM") << RESET << endl;
         return;
     }
@@ -43,20 +52,7 @@ void mostExpensiveInArea(const Property properties[], int propertyCount) {
     
     getValidStringInput((CYAN + getTranslatedString("PROMPT_REPORT_AREA") + RESET).c_str(), searchArea, sizeof(searchArea));
 
-    double maxPrice = -1.0; 
-    int mostExpensiveIndex = -1; 
-
-    
-    for (int i = 0; i < propertyCount; i++) {
-        
-        if (strcmp(properties[i].area, searchArea) == 0) {
-            
-            if (properties[i].price > maxPrice) {
-                maxPrice = properties[i].price;
-                mostExpensiveIndex = i; 
-            }
-        }
-    }
+    int mostExpensiveIndex = findMostExpensiveInArea(store, searchArea); 
 
     
     if (mostExpensiveIndex == -1) {
@@ -67,22 +63,21 @@ void mostExpensiveInArea(const Property properties[], int propertyCount) {
 
     cout << YELLOW << "\n--- " << getTranslatedString("MOST_EXPENSIVE_PROPERTY_IN_AREA") << " " << searchArea << " ---" << RESET << endl;
     
-    displayPropertyDetails(properties[mostExpensiveIndex]);
+    displayPropertyDetails(store.view(mostExpensiveIndex));
 }
 
 /**
  * @brief Изчислява и показва средната цена на имотите в указан от потребителя район.
  *
- * Тази функция подканва потребителя за район. След това тя итерира през всички имоти,
- * сумирайки цените на имотите в този район и преброявайки колко от тях
- * съществуват. Накрая, тя изчислява и показва средната цена,
- * или съобщение за грешка, ако не са намерени имоти в района или ако системата е празна.
+ * Тази функция подканва потребителя за район и взема броя и сумата на цените на имотите
+ * в него от обобщените стойности по райони, поддържани от контейнера, без да обхожда
+ * каталога. Накрая, тя изчислява и показва средната цена и медианата, която за разлика
+ * от средното не се влияе от отделни много скъпи имоти, или съобщение за грешка, ако не са намерени имоти в района или ако системата е празна.
  *
- * @param properties Постоянен масив от структури `Property` за анализ.
- * @param propertyCount Броят на валидните имоти в масива.
+ * @param store Контейнерът с имоти за анализ.
  */
-void averagePriceInArea(const Property properties[], int propertyCount) {
-    if (propertyCount == 0) {
+void averagePriceInArea(const PropertyStore& store) {
+    if (store.empty()) {
         cout << YELLOW << getTranslatedString("NO_PROPERTIES_IN_SYSTEM") << RESET << endl;
         return;
     }
@@ -92,15 +87,7 @@ void averagePriceInArea(const Property properties[], int propertyCount) {
     getValidStringInput((CYAN + getTranslatedString("PROMPT_REPORT_AREA") + RESET).c_str(), searchArea, sizeof(searchArea));
 
     double totalPrice = 0.0;     
-    int propertiesInAreaCount = 0; 
-
-    
-    for (int i = 0; i < propertyCount; i++) {
-        if (strcmp(properties[i].area, searchArea) == 0) {
-            totalPrice += properties[i].price;
-            propertiesInAreaCount++;
-        }
-    }
+    int propertiesInAreaCount = sumPricesInArea(store, searchArea, totalPrice); 
 
     
     if (propertiesInAreaCount == 0) {
@@ -110,49 +97,35 @@ void averagePriceInArea(const Property properties[], int propertyCount) {
 
     cout << YELLOW << "\n--- " << getTranslatedString("FOUND_PROPERTIES_COUNT_PART1") << " " << propertiesInAreaCount << " " << getTranslatedString("FOUND_PROPERTIES_COUNT_PART2") << " " << totalPrice << " ---" << RESET << endl;
     cout << getTranslatedString("AVERAGE_PRICE_IN_AREA_PART1") << " '" << searchArea << "' " << getTranslatedString("AVERAGE_PRICE_IN_AREA_PART2") << " " << fixed << setprecision(2) << totalPrice / propertiesInAreaCount << "." << endl;
+    cout << getTranslatedString("MEDIAN_PRICE_IN_AREA") << " " << fixed << setprecision(2) << medianPriceInArea(store, searchArea) << endl;
 }
 
 /**
  * @brief Изчислява и показва процента на продадените имоти за всеки уникален брокер.
  *
- * Тази функция ефективно събира статистика за всеки брокер, използвайки `std::map`.
- * Тя итерира през всички имоти, увеличавайки общия брой и броя на продадените имоти за всеки брокер.
- * Този подход динамично обработва произволен брой уникални брокери без ограниченията на масивите с фиксиран размер.
- * Накрая, тя представя процента на продадените имоти за всеки брокер, предлагайки ценни прозрения
- * за индивидуалната ефективност на брокерите.
+ * Статистиката се събира от `computeSalesPerBroker`, която обхожда само колоните
+ * с идентификатори на брокери и статуси. Брокерите се показват в азбучен ред,
+ * а тези без нито един имот (останали в речника след изтриване) се пропускат.
  *
- * @param properties Постоянен масив от структури `Property` за анализ.
- * @param propertyCount Броят на валидните имоти в масива.
+ * @param store Контейнерът с имоти за анализ.
  */
-void soldPercentagePerBroker(const Property properties[], int propertyCount) {
-    if (propertyCount == 0) {
+void soldPercentagePerBroker(const PropertyStore& store) {
+    if (store.empty()) {
         cout << YELLOW << getTranslatedString("NO_PROPERTIES_IN_SYSTEM") << RESET << endl;
         return;
     }
 
-    
-    
-    std::map<std::string, std::pair<int, int>> brokerStats;
-
-    
-    for (int i = 0; i < propertyCount; i++) {
-        const Property& prop = properties[i];
-        std::string brokerName = prop.broker; 
-
-        brokerStats[brokerName].first++; 
-        if (prop.status == SOLD) {
-            brokerStats[brokerName].second++; 
-        }
-    }
+    const StringDictionary& brokers = store.brokers();
+    vector<BrokerSales> salesPerBroker = computeSalesPerBroker(store);
 
     cout << YELLOW << "\n--- " << getTranslatedString("SOLD_PERCENTAGE_PER_BROKER_HEADER") << " ---" << RESET << endl;
 
     
     
-    for (const auto& pair : brokerStats) {
-        const std::string& brokerName = pair.first;
-        int totalBrokerProperties = pair.second.first;
-        int soldBrokerProperties = pair.second.second;
+    for (const BrokerSales& sales : salesPerBroker) {
+        const char* brokerName = brokers.lookup(sales.brokerId);
+        int totalBrokerProperties = sales.total;
+        int soldBrokerProperties = sales.sold;
 
         double soldBrokerPercentage = 0.0;
         if (totalBrokerProperties > 0) {
@@ -167,3 +140,697 @@ void soldPercentagePerBroker(const Property properties[], int propertyCount) {
         cout << endl;
     }
 }
+
+/**
+ * @brief Подканва потребителя за броя K на имотите в отчет от тип „първите K“.
+ */
+static size_t promptTopCount() {
+    while (true) {
+        int count = getValidNumericInput<int>((CYAN + getTranslatedString("PROMPT_TOP_COUNT") + RESET).c_str());
+        if (count > 0) {
+            return (size_t)count;
+        }
+        cout << RED << getTranslatedString("ERROR_TOP_COUNT_POSITIVE") << RESET << endl;
+    }
+}
+
+/**
+ * @brief Показва K-те най-скъпи имота в указан от потребителя район.
+ *
+ * Подканва за район и за K, след което показва имотите по цена в низходящ ред.
+ *
+ * @param store Контейнерът с имоти за анализ.
+ */
+void topExpensiveInArea(const PropertyStore& store) {
+    if (store.empty()) {
+        cout << YELLOW << getTranslatedString("NO_PROPERTIES_IN_SYSTEM") << RESET << endl;
+        return;
+    }
+
+    char searchArea[50];
+    getValidStringInput((CYAN + getTranslatedString("PROMPT_REPORT_AREA") + RESET).c_str(), searchArea, sizeof(searchArea));
+    size_t count = promptTopCount();
+
+    vector<uint32_t> slots = findTopExpensiveInArea(store, searchArea, count);
+    if (slots.empty()) {
+        cout << RED << getTranslatedString("NO_PROPERTIES_FOUND_IN_AREA") << RESET << endl;
+        return;
+    }
+
+    cout << YELLOW << "\n--- " << getTranslatedString("TOP_EXPENSIVE_IN_AREA_HEADER") << " " << searchArea << " ---" << RESET << endl;
+    displayPropertyList(store, slots);
+}
+
+/**
+ * @brief Показва K-те имота с най-голяма обща площ, взети от подредения индекс по площ.
+ *
+ * @param store Контейнерът с имоти за анализ.
+ */
+void topLargestProperties(const PropertyStore& store) {
+    if (store.empty()) {
+        cout << YELLOW << getTranslatedString("NO_PROPERTIES_IN_SYSTEM") << RESET << endl;
+        return;
+    }
+
+    size_t count = promptTopCount();
+    vector<uint32_t> slots = findLargestProperties(store, count);
+
+    cout << YELLOW << "\n--- " << getTranslatedString("TOP_LARGEST_HEADER") << " ---" << RESET << endl;
+    displayPropertyList(store, slots);
+}
+
+/**
+ * @brief Показва K-те имота с най-ниска цена на квадратен метър.
+ *
+ * Пред всеки имот се показва и цената му на квадратен метър.
+ *
+ * @param store Контейнерът с имоти за анализ.
+ */
+void topCheapestPerSquareMetre(const PropertyStore& store) {
+    if (store.empty()) {
+        cout << YELLOW << getTranslatedString("NO_PROPERTIES_IN_SYSTEM") << RESET << endl;
+        return;
+    }
+
+    size_t count = promptTopCount();
+    vector<uint32_t> slots = findCheapestPerSquareMetre(store, count);
+    if (slots.empty()) {
+        cout << YELLOW << getTranslatedString("NO_PROPERTIES_WITH_AREA_GREATER_THAN_ZERO") << RESET << endl;
+        return;
+    }
+
+    const double* prices = store.prices();
+    const double* totalAreas = store.totalAreas();
+    cout << YELLOW << "\n--- " << getTranslatedString("TOP_CHEAPEST_PER_SQ_M_HEADER") << " ---" << RESET << endl;
+    for (size_t i = 0; i < slots.size(); i++) {
+        cout << YELLOW << "--- " << getTranslatedString("PROPERTY_HEADER") << " #" << i + 1 << " (" << fixed << setprecision(2)
+             << prices[slots[i]] / totalAreas[slots[i]] << " " << getTranslatedString("PRICE_PER_SQ_M") << ")" << RESET << endl;
+        displayPropertyDetails(store.view(slots[i]));
+    }
+}
+
+/**
+ * @brief Ключове на преводите за имената на полетата за групиране, числовите полета и показателите.
+ */
+static const char* const GROUP_FIELD_KEYS[GROUP_FIELD_COUNT] = {
+    "BROKER_SHORT", "AREA_SHORT", "TYPE_SHORT", "EXPOSITION_SHORT", "STATUS_SHORT", "ROOMS_SHORT"
+};
+static const char* const MEASURE_KEYS[MEASURE_FIELD_COUNT] = {
+    "REPORT_MEASURE_PRICE", "REPORT_MEASURE_TOTAL_AREA", "REPORT_MEASURE_FLOOR", "REPORT_MEASURE_ROOMS", "REPORT_MEASURE_SOLD",
+    "REPORT_MEASURE_PRICE_PER_SQM"
+};
+static const char* const METRIC_KEYS[METRIC_COUNT_ALL] = {
+    "REPORT_METRIC_COUNT", "REPORT_METRIC_SUM", "REPORT_METRIC_AVERAGE", "REPORT_METRIC_MIN", "REPORT_METRIC_MAX", "REPORT_METRIC_STDDEV",
+    "REPORT_METRIC_MEDIAN", "REPORT_METRIC_P90", "REPORT_METRIC_P99"
+};
+
+/**
+ * @brief Подканва за избор в `[min, max]`, докато не бъде въведена валидна стойност.
+ */
+static int promptValidChoice(int min, int max) {
+    while (true) {
+        int choice = getMenuChoice(min, max);
+        if (choice != -1) {
+            return choice;
+        }
+        cout << RED << getTranslatedString("INVALID_OPTION") << RESET << endl;
+    }
+}
+
+/**
+ * @brief Показва номериран списък от преведени имена.
+ */
+static void printOptions(const char* const* keys, int count) {
+    for (int i = 0; i < count; i++) {
+        cout << "  " << i + 1 << ". " << getTranslatedString(keys[i]) << endl;
+    }
+}
+
+/**
+ * @brief Показва справка по избор.
+ *
+ * Полетата за групиране се избират едно по едно (повторен избор се пропуска), а за всеки
+ * показател освен броя се избира и числово поле. Ако не е избран нито един показател,
+ * се показва броят на имотите в групите. Стойностите се изчисляват с едно обхождане на
+ * каталога, а групите се показват подредени по полетата за групиране.
+ *
+ * @param store Контейнерът с имоти за анализ.
+ */
+void customGroupReport(const PropertyStore& store) {
+    if (store.empty()) {
+        cout << YELLOW << getTranslatedString("NO_PROPERTIES_IN_SYSTEM") << RESET << endl;
+        return;
+    }
+
+    GroupReportSpec spec;
+    cout << CYAN << getTranslatedString("GROUP_REPORT_FIELDS_TITLE") << RESET << endl;
+    printOptions(GROUP_FIELD_KEYS, GROUP_FIELD_COUNT);
+    while ((int)spec.groupBy.size() < GROUP_FIELD_COUNT) {
+        int choice = promptValidChoice(0, GROUP_FIELD_COUNT);
+        if (choice == 0) break;
+        GroupField field = (GroupField)(choice - 1);
+        if (find(spec.groupBy.begin(), spec.groupBy.end(), field) == spec.groupBy.end()) {
+            spec.groupBy.push_back(field);
+        }
+    }
+
+    cout << CYAN << getTranslatedString("GROUP_REPORT_METRICS_TITLE") << RESET << endl;
+    printOptions(METRIC_KEYS, METRIC_COUNT_ALL);
+    while (true) {
+        int choice = promptValidChoice(0, METRIC_COUNT_ALL);
+        if (choice == 0) break;
+        MetricSpec metric = {(Metric)(choice - 1), MEASURE_PRICE};
+        if (metric.metric != METRIC_COUNT) {
+            cout << CYAN << getTranslatedString("GROUP_REPORT_MEASURE_TITLE") << RESET << endl;
+            printOptions(MEASURE_KEYS, MEASURE_FIELD_COUNT);
+            metric.field = (MeasureField)(promptValidChoice(1, MEASURE_FIELD_COUNT) - 1);
+        }
+        spec.metrics.push_back(metric);
+    }
+    if (spec.metrics.empty()) {
+        spec.metrics.push_back({METRIC_COUNT, MEASURE_PRICE});
+    }
+
+    vector<GroupReportRow> rows = buildGroupReport(store, spec);
+
+    cout << YELLOW << "\n--- " << getTranslatedString("GROUP_REPORT_HEADER") << " ---" << RESET << endl;
+    cout << left;
+    for (GroupField field : spec.groupBy) {
+        cout << setw(16) << getTranslatedString(GROUP_FIELD_KEYS[field]) << " ";
+    }
+    for (const MetricSpec& metric : spec.metrics) {
+        string title = getTranslatedString(METRIC_KEYS[metric.metric]);
+        if (metric.metric != METRIC_COUNT) {
+            title += " (" + getTranslatedString(MEASURE_KEYS[metric.field]) + ")";
+        }
+        cout << setw(20) << title << " ";
+    }
+    cout << endl;
+
+    for (const GroupReportRow& row : rows) {
+        if (spec.groupBy.empty()) {
+            cout << getTranslatedString("GROUP_REPORT_TOTAL") << ": ";
+        }
+        for (size_t i = 0; i < row.keys.size(); i++) {
+            cout << setw(16) << groupKeyText(store, spec.groupBy[i], row.keys[i], true) << " ";
+        }
+        for (size_t i = 0; i < row.values.size(); i++) {
+            cout << setw(20) << fixed << setprecision(spec.metrics[i].metric == METRIC_COUNT ? 0 : 2) << row.values[i] << " ";
+        }
+        cout << endl;
+    }
+}
+
+/**
+ * @brief Подканва потребителя да избере едно от изброените полета за групиране.
+ */
+static GroupField promptGroupField(const char* titleKey, const GroupField* fields, int count) {
+    cout << CYAN << getTranslatedString(titleKey) << RESET << endl;
+    for (int i = 0; i < count; i++) {
+        cout << "  " << i + 1 << ". " << getTranslatedString(GROUP_FIELD_KEYS[fields[i]]) << endl;
+    }
+    return fields[promptValidChoice(1, count) - 1];
+}
+
+/**
+ * @brief Изчислява и показва отчет с едно поле за групиране като таблица.
+ *
+ * Заглавията на колоните са имената на показателите; броят се показва без знаци след запетаята.
+ */
+static void showSingleFieldReport(const PropertyStore& store, const GroupReportSpec& spec, const char* headerKey) {
+    GroupField field = spec.groupBy[0];
+    vector<GroupReportRow> rows = buildGroupReport(store, spec);
+
+    cout << YELLOW << "\n--- " << getTranslatedString(headerKey) << " ---" << RESET << endl;
+    cout << left << setw(20) << getTranslatedString(GROUP_FIELD_KEYS[field]) << " ";
+    for (const MetricSpec& metric : spec.metrics) {
+        cout << setw(18) << getTranslatedString(METRIC_KEYS[metric.metric]) << " ";
+    }
+    cout << endl;
+    for (const GroupReportRow& row : rows) {
+        cout << setw(20) << groupKeyText(store, field, row.keys[0], true) << " ";
+        for (size_t i = 0; i < row.values.size(); i++) {
+            cout << setw(18) << fixed << setprecision(spec.metrics[i].metric == METRIC_COUNT ? 0 : 2) << row.values[i] << " ";
+        }
+        cout << endl;
+    }
+}
+
+/**
+ * @brief Показва медианата, 90-ия и 99-ия персентил на цените по район или по тип имот.
+ *
+ * Отчетът е `buildGroupReport` с едно поле за групиране и квантилни показатели върху цената,
+ * така че персентилите се изчисляват със сливаеми скици при едно обхождане на каталога
+ * (паралелно при голям каталог), без сортиране на цените.
+ *
+ * @param store Контейнерът с имоти за анализ.
+ */
+void pricePercentiles(const PropertyStore& store) {
+    if (store.empty()) {
+        cout << YELLOW << getTranslatedString("NO_PROPERTIES_IN_SYSTEM") << RESET << endl;
+        return;
+    }
+
+    static const GroupField FIELDS[] = {GROUP_AREA, GROUP_TYPE};
+    GroupReportSpec spec;
+    spec.groupBy.push_back(promptGroupField("PRICE_PERCENTILES_GROUP_TITLE", FIELDS, 2));
+    for (Metric metric : {METRIC_COUNT, METRIC_MEDIAN, METRIC_P90, METRIC_P99}) {
+        spec.metrics.push_back({metric, MEASURE_PRICE});
+    }
+    showSingleFieldReport(store, spec, "PRICE_PERCENTILES_HEADER");
+    cout << getTranslatedString("PRICE_PERCENTILES_NOTE") << endl;
+}
+
+/**
+ * @brief Показва броя, средната, минималната, максималната и медианната цена на кв.м.
+ * по район, по тип или по брой стаи.
+ *
+ * Цената на кв.м. се изчислява за всички имоти наведнъж с векторизираното ядро
+ * `computePricePerSquareMetre`; имотите без положителна площ се броят, но не участват в цените.
+ *
+ * @param store Контейнерът с имоти за анализ.
+ */
+void pricePerSquareMetreReport(const PropertyStore& store) {
+    if (store.empty()) {
+        cout << YELLOW << getTranslatedString("NO_PROPERTIES_IN_SYSTEM") << RESET << endl;
+        return;
+    }
+
+    static const GroupField FIELDS[] = {GROUP_AREA, GROUP_TYPE, GROUP_ROOMS};
+    GroupReportSpec spec;
+    spec.groupBy.push_back(promptGroupField("PRICE_PER_SQ_M_GROUP_TITLE", FIELDS, 3));
+    for (Metric metric : {METRIC_COUNT, METRIC_AVERAGE, METRIC_MIN, METRIC_MAX, METRIC_MEDIAN}) {
+        spec.metrics.push_back({metric, MEASURE_PRICE_PER_SQM});
+    }
+    showSingleFieldReport(store, spec, "PRICE_PER_SQ_M_REPORT_HEADER");
+}
+
+/**
+ * @brief Показва имотите, чиято цена на кв.м. се отклонява от средната за района им
+ * с повече от зададения от потребителя брой стандартни отклонения.
+ *
+ * Имотите се показват от най-голямото към най-малкото отклонение, като пред всеки
+ * се показват цената му на кв.м. и отклонението в стандартни отклонения.
+ *
+ * @param store Контейнерът с имоти за анализ.
+ */
+void pricePerSquareMetreOutliers(const PropertyStore& store) {
+    if (store.empty()) {
+        cout << YELLOW << getTranslatedString("NO_PROPERTIES_IN_SYSTEM") << RESET << endl;
+        return;
+    }
+
+    double sigmas = 0.0;
+    while (true) {
+        sigmas = getValidNumericInput<double>((CYAN + getTranslatedString("PROMPT_OUTLIER_SIGMAS") + RESET).c_str());
+        if (sigmas > 0.0) {
+            break;
+        }
+        cout << RED << getTranslatedString("ERROR_OUTLIER_SIGMAS_POSITIVE") << RESET << endl;
+    }
+
+    vector<PriceOutlier> outliers = findPricePerSquareMetreOutliers(store, sigmas);
+    if (outliers.empty()) {
+        cout << YELLOW << getTranslatedString("NO_PRICE_PER_SQ_M_OUTLIERS") << RESET << endl;
+        return;
+    }
+
+    cout << YELLOW << "\n--- " << getTranslatedString("PRICE_PER_SQ_M_OUTLIERS_HEADER") << " ---" << RESET << endl;
+    for (size_t i = 0; i < outliers.size(); i++) {
+        cout << YELLOW << "--- " << getTranslatedString("PROPERTY_HEADER") << " #" << i + 1 << " (" << fixed << setprecision(2)
+             << outliers[i].pricePerSqm << " " << getTranslatedString("PRICE_PER_SQ_M") << ", " << showpos << outliers[i].deviation
+             << noshowpos << " " << getTranslatedString("STANDARD_DEVIATIONS_FROM_AREA_MEAN") << ")" << RESET << endl;
+        displayPropertyDetails(store.view(outliers[i].slot));
+    }
+}
+
+/**
+ * @brief Ключове на преводите за редовете на отчета за всички райони.
+ */
+static const char* const AREA_SORT_KEYS[AREA_SORT_ORDER_COUNT] = {
+    "ALL_AREAS_SORT_NAME", "ALL_AREAS_SORT_COUNT", "ALL_AREAS_SORT_AVERAGE", "ALL_AREAS_SORT_MAX_PRICE"
+};
+
+/**
+ * @brief Показва или записва във файл броя, средната и най-високата цена за всички райони.
+ *
+ * Всички райони се изчисляват с едно обхождане на каталога чрез `computeAreaSummaries`
+ * (на няколко нишки при голям каталог), вместо с по едно търсене за всеки район.
+ * Таблицата се записва във файл, ако потребителят въведе път, или се показва на екрана.
+ *
+ * @param store Контейнерът с имоти за анализ.
+ */
+void allAreasReport(const PropertyStore& store) {
+    if (store.empty()) {
+        cout << YELLOW << getTranslatedString("NO_PROPERTIES_IN_SYSTEM") << RESET << endl;
+        return;
+    }
+
+    cout << CYAN << getTranslatedString("ALL_AREAS_SORT_TITLE") << RESET << endl;
+    printOptions(AREA_SORT_KEYS, AREA_SORT_ORDER_COUNT);
+    AreaSortOrder order = (AreaSortOrder)(promptValidChoice(1, AREA_SORT_ORDER_COUNT) - 1);
+
+    cout << CYAN << getTranslatedString("PROMPT_ALL_AREAS_FILE_PATH") << RESET;
+    string path;
+    getline(cin, path);
+
+    vector<AreaSummary> summaries = computeAreaSummaries(store);
+    sortAreaSummaries(store, summaries, order);
+
+    if (path.empty()) {
+        cout << YELLOW << "\n--- " << getTranslatedString("ALL_AREAS_HEADER") << " ---" << RESET << endl;
+        cout << flush;
+        writeAreaSummaryTable(stdout, store, summaries);
+        fflush(stdout);
+        return;
+    }
+
+    if (!confirmOverwrite(path.c_str())) return;
+    FILE* file = fopen(path.c_str(), "w");
+    if (file == NULL) {
+        cout << RED << getTranslatedString("ERROR_ALL_AREAS_FILE_OPEN") << " '" << path << "'." << RESET << endl;
+        return;
+    }
+    writeAreaSummaryTable(file, store, summaries);
+    fclose(file);
+    cout << GREEN << getTranslatedString("ALL_AREAS_SAVED") << " '" << path << "'." << RESET << endl;
+}
+
+/**
+ * @brief Намира позицията на най-скъпия имот в даден район.
+ *
+ * Имотът се взема от поддържаните от контейнера обобщени стойности за района, без обхождане.
+ *
+ * @param store Контейнерът с имоти за анализ.
+ * @param area Името на района.
+ * @return Позицията на имота или -1, ако в района няма имоти.
+ */
+int findMostExpensiveInArea(const PropertyStore& store, const char* area) {
+    int64_t areaId = store.areas().find(area);
+    if (areaId == -1) {
+        return -1;
+    }
+    return store.areaAggregate((uint32_t)areaId).mostExpensiveSlot;
+}
+
+/**
+ * @brief Намира позициите на K-те най-скъпи имота в даден район.
+ *
+ * Позициите се вземат от края на подредения по цена списък на района в индекса
+ * на контейнера за O(K), без обхождане на каталога.
+ *
+ * @param store Контейнерът с имоти за анализ.
+ * @param area Името на района.
+ * @param count Броят K.
+ * @return Позициите по цена в низходящ ред.
+ */
+vector<uint32_t> findTopExpensiveInArea(const PropertyStore& store, const char* area, size_t count) {
+    int64_t areaId = store.areas().find(area);
+    if (areaId == -1) {
+        return vector<uint32_t>();
+    }
+    return store.findByArea((uint32_t)areaId, false, count);
+}
+
+/**
+ * @brief Намира позициите на K-те имота с най-голяма обща площ чрез подредения индекс по площ.
+ *
+ * @param store Контейнерът с имоти за анализ.
+ * @param count Броят K.
+ * @return Позициите по обща площ в низходящ ред.
+ */
+vector<uint32_t> findLargestProperties(const PropertyStore& store, size_t count) {
+    return store.findTop(RANGE_TOTAL_AREA, count, true);
+}
+
+/**
+ * @brief Намира позициите на K-те имота с най-ниска цена на квадратен метър.
+ *
+ * Цената на кв.м. се изчислява при обхождането от колоните с цени и площи, без да се пази
+ * за всички имоти; в пирамидата остават само K-те най-добри.
+ *
+ * @param store Контейнерът с имоти за анализ.
+ * @param count Броят K.
+ * @return Позициите по цена на кв.м. във възходящ ред.
+ */
+vector<uint32_t> findCheapestPerSquareMetre(const PropertyStore& store, size_t count) {
+    TopKSelector<double> selector(count, false);
+    const double* prices = store.prices();
+    const double* totalAreas = store.totalAreas();
+
+    for (int i = 0; i < store.size(); i++) {
+        if (totalAreas[i] > 0.0) {
+            selector.offer(prices[i] / totalAreas[i], (uint32_t)i);
+        }
+    }
+    return selector.slots();
+}
+
+/**
+ * @brief Сумира цените на имотите в даден район.
+ *
+ * Броят и сумата се поддържат от контейнера при всяка промяна и се вземат за O(1).
+ *
+ * @param store Контейнерът с имоти за анализ.
+ * @param area Името на района.
+ * @param totalPrice Изходен параметър за сумата на цените.
+ * @return Броят на имотите в района.
+ */
+int sumPricesInArea(const PropertyStore& store, const char* area, double& totalPrice) {
+    totalPrice = 0.0;
+    int64_t areaId = store.areas().find(area);
+    if (areaId == -1) {
+        return 0;
+    }
+
+    AreaAggregate aggregate = store.areaAggregate((uint32_t)areaId);
+    totalPrice = aggregate.totalPrice;
+    return aggregate.count;
+}
+
+/**
+ * @brief Намира имотите, чиято цена на кв.м. се отклонява от средната за района им
+ * с повече от `sigmas` стандартни отклонения.
+ *
+ * Средното и стандартното отклонение по райони се изчисляват с `buildGroupReport`, след което
+ * колоната с цени на кв.м. се сравнява със стойностите на района на всеки имот с векторизираното
+ * ядро `flagDeviations`. В район с нулево отклонение (всички цени на кв.м. са равни) няма отклонения.
+ *
+ * @param store Контейнерът с имоти за анализ.
+ * @param sigmas Допустимият брой стандартни отклонения.
+ * @return Отклоненията, подредени по абсолютната им стойност в низходящ ред, а при равенство - по позиция.
+ */
+vector<PriceOutlier> findPricePerSquareMetreOutliers(const PropertyStore& store, double sigmas) {
+    vector<PriceOutlier> outliers;
+    int rowCount = store.size();
+    if (rowCount == 0) {
+        return outliers;
+    }
+
+    GroupReportSpec spec;
+    spec.groupBy.push_back(GROUP_AREA);
+    spec.metrics.push_back({METRIC_AVERAGE, MEASURE_PRICE_PER_SQM});
+    spec.metrics.push_back({METRIC_STDDEV, MEASURE_PRICE_PER_SQM});
+    int areaCount = store.areas().size();
+    vector<double> means(areaCount, 0.0);
+    vector<double> deviations(areaCount, 0.0);
+    vector<double> limits(areaCount, numeric_limits<double>::infinity());
+    for (const GroupReportRow& row : buildGroupReport(store, spec)) {
+        uint32_t areaId = (uint32_t)row.keys[0];
+        means[areaId] = row.values[0];
+        deviations[areaId] = row.values[1];
+        if (row.values[1] > 0.0) {
+            limits[areaId] = sigmas * row.values[1];
+        }
+    }
+
+    vector<double> pricePerSqm(rowCount);
+    computePricePerSquareMetre(store.prices(), store.totalAreas(), rowCount, pricePerSqm.data());
+    vector<unsigned char> flags(rowCount);
+    const uint32_t* areaIds = store.areaIds();
+    outliers.reserve(flagDeviations(pricePerSqm.data(), areaIds, means.data(), limits.data(), rowCount, flags.data()));
+    for (int i = 0; i < rowCount; i++) {
+        if (flags[i]) {
+            double deviation = (pricePerSqm[i] - means[areaIds[i]]) / deviations[areaIds[i]];
+            outliers.push_back({(uint32_t)i, pricePerSqm[i], deviation});
+        }
+    }
+    sort(outliers.begin(), outliers.end(), [](const PriceOutlier& a, const PriceOutlier& b) {
+        if (fabs(a.deviation) != fabs(b.deviation)) {
+            return fabs(a.deviation) > fabs(b.deviation);
+        }
+        return a.slot < b.slot;
+    });
+    return outliers;
+}
+
+/**
+ * @brief Частични стойности на един район при групиране с `groupByDenseKey`.
+ *
+ * Дяловете на нишките са последователни и се сливат по ред, затова при еднаква цена
+ * остава имотът с по-малка позиция, както в `PropertyStore::areaAggregate`.
+ */
+struct AreaTotals {
+    int count;
+    double totalPrice;
+    double maxPrice;
+    int maxSlot;
+
+    AreaTotals& operator+=(const AreaTotals& other) {
+        if (other.count > 0 && (count == 0 || other.maxPrice > maxPrice)) {
+            maxPrice = other.maxPrice;
+            maxSlot = other.maxSlot;
+        }
+        count += other.count;
+        totalPrice += other.totalPrice;
+        return *this;
+    }
+};
+
+/**
+ * @brief Изчислява броя, сумата на цените и най-скъпия имот за всички райони с едно обхождане.
+ *
+ * Имотите се групират по идентификатора на района чрез `groupByDenseKey`: при голям каталог
+ * всяка нишка обработва непрекъснат дял от колоните с цени и райони в собствен масив,
+ * а масивите се сливат накрая.
+ *
+ * @param store Контейнерът с имоти за анализ.
+ * @param threadCount Брой нишки; 0 избира автоматично.
+ * @return Районите с поне един имот, подредени по име.
+ */
+vector<AreaSummary> computeAreaSummaries(const PropertyStore& store, int threadCount) {
+    const double* prices = store.prices();
+    vector<AreaTotals> totals = groupByDenseKey<AreaTotals>(store.areaIds(), store.size(), store.areas().size(),
+        [prices](AreaTotals& area, int row) {
+            if (area.count == 0 || prices[row] > area.maxPrice) {
+                area.maxPrice = prices[row];
+                area.maxSlot = row;
+            }
+            area.count++;
+            area.totalPrice += prices[row];
+        }, threadCount);
+
+    vector<AreaSummary> summaries;
+    for (size_t id = 0; id < totals.size(); id++) {
+        if (totals[id].count > 0) {
+            summaries.push_back({(uint32_t)id, totals[id].count, totals[id].totalPrice, totals[id].maxSlot});
+        }
+    }
+    sortAreaSummaries(store, summaries, AREA_SORT_BY_NAME);
+    return summaries;
+}
+
+/**
+ * Сравнява районите по избраната стойност, а при равенство - по име, за да бъде редът еднозначен.
+ */
+void sortAreaSummaries(const PropertyStore& store, vector<AreaSummary>& summaries, AreaSortOrder order) {
+    const StringDictionary& areas = store.areas();
+    const double* prices = store.prices();
+    auto value = [order, prices](const AreaSummary& area) {
+        switch (order) {
+            case AREA_SORT_BY_COUNT: return (double)area.count;
+            case AREA_SORT_BY_AVERAGE: return area.totalPrice / area.count;
+            case AREA_SORT_BY_MAX_PRICE: return prices[area.mostExpensiveSlot];
+            default: return 0.0;
+        }
+    };
+    sort(summaries.begin(), summaries.end(), [&areas, &value](const AreaSummary& a, const AreaSummary& b) {
+        double first = value(a);
+        double second = value(b);
+        if (first != second) {
+            return first > second;
+        }
+        return strcmp(areas.lookup(a.areaId), areas.lookup(b.areaId)) < 0;
+    });
+}
+
+void writeAreaSummaryTable(FILE* file, const PropertyStore& store, const vector<AreaSummary>& summaries) {
+    fprintf(file, "-----------------------------------------------------------------------------------\n");
+    fprintf(file, "| %-15s | %-8s | %-15s | %-15s | %-14s |\n", getTranslatedString("AREA_SHORT").c_str(),
+            getTranslatedString("REPORT_METRIC_COUNT").c_str(), getTranslatedString("ALL_AREAS_AVERAGE_PRICE").c_str(),
+            getTranslatedString("ALL_AREAS_MAX_PRICE").c_str(), getTranslatedString("ALL_AREAS_MAX_REF").c_str());
+    fprintf(file, "-----------------------------------------------------------------------------------\n");
+    for (const AreaSummary& area : summaries) {
+        PropertyView mostExpensive = store.view(area.mostExpensiveSlot);
+        fprintf(file, "| %-15s | %8d | %15.2f | %15.2f | %14d |\n", store.areas().lookup(area.areaId), area.count,
+                area.totalPrice / area.count, mostExpensive.price, mostExpensive.refNumber);
+    }
+    fprintf(file, "-----------------------------------------------------------------------------------\n");
+}
+
+bool parseAreaSortOrder(const char* name, AreaSortOrder& order) {
+    static const char* const NAMES[AREA_SORT_ORDER_COUNT] = {"name", "count", "average", "max"};
+    for (int i = 0; i < AREA_SORT_ORDER_COUNT; i++) {
+        if (strcmp(name, NAMES[i]) == 0) {
+            order = (AreaSortOrder)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Връща точната медиана на цените в даден район.
+ *
+ * Медианата се взема по ранг от подредения по цена списък на района, който контейнерът
+ * поддържа при всяка промяна, без сортиране и без обхождане на каталога.
+ *
+ * @param store Контейнерът с имоти за анализ.
+ * @param area Името на района.
+ * @return Медианата или 0, ако в района няма имоти.
+ */
+double medianPriceInArea(const PropertyStore& store, const char* area) {
+    int64_t areaId = store.areas().find(area);
+    if (areaId == -1) {
+        return 0.0;
+    }
+    return store.areaPriceQuantile((uint32_t)areaId, 0.5);
+}
+
+/**
+ * @brief Частична статистика на един брокер при групиране с `groupByDenseKey`.
+ */
+struct BrokerCounts {
+    int total;
+    int sold;
+
+    BrokerCounts& operator+=(const BrokerCounts& other) {
+        total += other.total;
+        sold += other.sold;
+        return *this;
+    }
+};
+
+/**
+ * @brief Събира броя на всички и на продадените имоти за всеки брокер.
+ *
+ * Имотите се групират по идентификатора на брокера от речника на контейнера чрез
+ * `groupByDenseKey`, без да се създават низове за всеки имот. При голям каталог всяка
+ * нишка брои своя дял от имотите в собствен масив, а масивите се сливат накрая; тъй като
+ * броят се сумира точно, резултатът не зависи от броя на нишките. Брокерите без нито един
+ * имот (останали в речника след изтриване) се пропускат.
+ *
+ * @param store Контейнерът с имоти за анализ.
+ * @param threadCount Брой нишки; 0 избира автоматично.
+ * @return Статистиката по брокери, подредена по име на брокера.
+ */
+vector<BrokerSales> computeSalesPerBroker(const PropertyStore& store, int threadCount) {
+    const StringDictionary& brokers = store.brokers();
+    const unsigned char* statuses = store.statuses();
+    vector<BrokerCounts> countsPerBroker = groupByDenseKey<BrokerCounts>(store.brokerIds(), store.size(), brokers.size(),
+        [statuses](BrokerCounts& counts, int row) {
+            counts.total++;
+            counts.sold += (statuses[row] == SOLD);
+        }, threadCount);
+
+    vector<BrokerSales> salesPerBroker;
+    for (int id = 0; id < brokers.size(); id++) {
+        if (countsPerBroker[id].total > 0) {
+            salesPerBroker.push_back({(uint32_t)id, countsPerBroker[id].total, countsPerBroker[id].sold});
+        }
+    }
+    sort(salesPerBroker.begin(), salesPerBroker.end(), [&brokers](const BrokerSales& a, const BrokerSales& b) {
+        return strcmp(brokers.lookup(a.brokerId), brokers.lookup(b.brokerId)) < 0;
+    });
+    return salesPerBroker;
+}
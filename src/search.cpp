@@ -3,22 +3,27 @@
  * @brief Имплементация на функции за търсене и филтриране на имоти по различни критерии.
  *
  * Този файл предоставя конкретната имплементация на функциите, декларирани в `search.h`,
- * позволявайки на потребителите да търсят имоти по име на брокер или по брой стаи.
- * Резултатите от търсенето могат да бъдат сортирани по цена, за да помогнат на потребителите
+ * позволявайки на потребителите да търсят имоти по име на брокер, по брой стаи
+ * или по интервали от стойности на цена, обща площ, етаж и брой стаи.
+ * Всички търсения се изпълняват чрез `Query::findSlotsByPrice`, така че условията
+ * се прилагат по един и същи начин в менюто, в пакетния режим и в свободните заявки.
+ * Резултатите от търсенето са подредени по цена, за да помогнат на потребителите
  * да анализират и сравняват обявите.
  */
 
 #include <iostream>    
-#include <limits>      
 #include <cstring>     
 #include <algorithm>   
+#include <vector>      
 
 #include "search.h"    
 #include "structs.h"   
+#include "store.h"     
+#include "query.h"     
 #include "display.h"   
-#include "sort.h"      
 #include "colors.h"    
 #include "add.h"       
+#include "utils.h"     
 #include "localization.h" 
 
 using namespace std;
@@ -26,17 +31,15 @@ using namespace std;
 /**
  * @brief Търси и показва имоти, обработени от конкретен брокер.
  *
- * Тази функция подканва потребителя за име на брокер. След това тя итерира през
- * масива от имоти, копирайки всички имоти, управлявани от указания брокер,
- * във временен масив. Ако са намерени имоти, тя допълнително подканва потребителя
- * да избере ред на сортиране (възходящ или низходящ по цена) и след това показва
- * намерените имоти.
+ * Тази функция подканва потребителя за име на брокер и намира неговите имоти чрез заявката
+ * `Query::broker`, която взема позициите от индекса по брокер, подреден по цена. Ако са намерени
+ * имоти, тя допълнително подканва потребителя да избере ред на сортиране (възходящ или низходящ
+ * по цена) и показва имотите в този ред; низходящият ред е обхождане на същия списък отзад напред, без сортиране.
  *
- * @param properties Масив от структури `Property` за търсене.
- * @param propertyCount Броят на валидните имоти в масива.
+ * @param store Контейнерът с имоти за търсене.
  */
-void searchByBroker(Property properties[], int propertyCount) {
-    if (propertyCount == 0) {
+void searchByBroker(const PropertyStore& store) {
+    if (store.empty()) {
         cout << YELLOW << getTranslatedString("NO_PROPERTIES_IN_SYSTEM") << RESET << endl;
         return;
     }
@@ -45,21 +48,11 @@ void searchByBroker(Property properties[], int propertyCount) {
     
     getValidStringInput((CYAN + getTranslatedString("PROMPT_SEARCH_BROKER_NAME") + RESET).c_str(), searchBroker, sizeof(searchBroker));
 
-    Property tempProperties[MAX_PROPERTIES]; 
-    int tempCount = 0;                       
-    bool isFound = false;                    
+    Query query = Query::broker(searchBroker);
+    vector<uint32_t> slots = query.findSlotsByPrice(store, true);
 
     
-    for (int i = 0; i < propertyCount; i++) {
-        if (strcmp(searchBroker, properties[i].broker) == 0) {
-            tempProperties[tempCount] = properties[i]; 
-            tempCount++;
-            isFound = true; 
-        }
-    }
-
-    
-    if (!isFound) {
+    if (slots.empty()) {
         cout << RED << getTranslatedString("NO_PROPERTIES_FOUND_FOR_BROKER") << " '" << searchBroker << "'." << RESET << endl;
         return;
     }
@@ -81,62 +74,155 @@ void searchByBroker(Property properties[], int propertyCount) {
     }
 
     
-    sortPropertiesArray(tempProperties, tempCount, isAscending);
+    if (!isAscending) {
+        slots = query.findSlotsByPrice(store, false);
+    }
 
     cout << YELLOW << "\n--- " << getTranslatedString("SEARCH_RESULTS_FOR_BROKER") << " '" << searchBroker << "' (" << getTranslatedString("SORTED_BY_PRICE") << ") ---" << RESET << endl;
-    
-    for (int i = 0; i < tempCount; i++) {
-        cout << YELLOW << "--- " << getTranslatedString("PROPERTY_HEADER") << " #" << i + 1 << RESET << endl;
-        displayPropertyDetails(tempProperties[i]);
-    }
+
+    displayPropertyList(store, slots);
 }
 
 /**
  * @brief Търси и показва имоти въз основа на броя стаи.
  *
- * Тази функция подканва потребителя за брой стаи. След това тя итерира през
- * масива от имоти, копирайки всички имоти, които съвпадат с указания брой
- * стаи във временен масив. Ако са намерени имоти, те се сортират
- * по цена (по подразбиране низходящо, както е указано от `false` в извикването на `sortPropertiesArray`)
- * и след това се показват на потребителя.
+ * Тази функция подканва потребителя за брой стаи и намира съвпадащите имоти чрез заявката
+ * `Query::rooms`, която взема позициите от индекса по брой стаи, вече подредени по цена
+ * (низходящо). Ако са намерени имоти, те се показват на потребителя в този ред.
  *
- * @param properties Масив от структури `Property` за търсене.
- * @param propertyCount Броят на валидните имоти в масива.
+ * @param store Контейнерът с имоти за търсене.
  */
-void searchByRooms(Property properties[], int propertyCount) {
-    if (propertyCount == 0) {
+void searchByRooms(const PropertyStore& store) {
+    if (store.empty()) {
         cout << YELLOW << getTranslatedString("NO_PROPERTIES_IN_SYSTEM") << RESET << endl;
         return;
     }
 
     int roomsCount = getValidNumericInput<int>((CYAN + getTranslatedString("PROMPT_SEARCH_ROOMS_COUNT") + RESET).c_str());
 
-    Property tempProperties[MAX_PROPERTIES]; 
-    int tempCount = 0;                       
-    bool isFound = false;                    
+    vector<uint32_t> slots = Query::rooms(roomsCount, roomsCount).findSlotsByPrice(store, false);
 
     
-    for (int i = 0; i < propertyCount; i++) {
-        if (properties[i].rooms == roomsCount) {
-            tempProperties[tempCount] = properties[i]; 
-            tempCount++;
-            isFound = true; 
+    if (slots.empty()) {
+        cout << RED << getTranslatedString("NO_PROPERTIES_FOUND_FOR_ROOMS_COUNT_PART1") << " " << roomsCount << " " << getTranslatedString("NO_PROPERTIES_FOUND_FOR_ROOMS_COUNT_PART2") << RESET << endl;
+        return;
+    }
+
+    cout << YELLOW << "\n--- " << getTranslatedString("SEARCH_RESULTS_FOR_ROOMS_COUNT_PART1") << " " << roomsCount << " " << getTranslatedString("SEARCH_RESULTS_FOR_ROOMS_COUNT_PART2") << " (" << getTranslatedString("SORTED_BY_PRICE") << ") ---" << RESET << endl;
+
+    displayPropertyList(store, slots);
+}
+
+/**
+ * @brief Намира позициите на имотите на даден брокер, подредени по цена.
+ *
+ * Търсенето се изпълнява като заявка `Query::broker`, чиито позиции се вземат директно
+ * от индекса по брокер на контейнера, който вече е подреден по цена.
+ *
+ * @param store Контейнерът с имоти, в който да се търси.
+ * @param broker Името на брокера.
+ * @param sortAscending true за възходящ ред по цена, false за низходящ.
+ * @return Позициите на съвпадащите имоти; при еднаква цена - в реда им в каталога.
+ */
+vector<uint32_t> findSlotsByBroker(const PropertyStore& store, const char* broker, bool sortAscending) {
+    return Query::broker(broker).findSlotsByPrice(store, sortAscending);
+}
+
+/**
+ * @brief Намира позициите на имотите с даден брой стаи, подредени по цена.
+ *
+ * Търсенето се изпълнява като заявка `Query::rooms` с еднакви граници, чиито позиции
+ * се вземат директно от групата за този брой стаи в индекса на контейнера.
+ *
+ * @param store Контейнерът с имоти, в който да се търси.
+ * @param roomsCount Търсеният брой стаи.
+ * @param sortAscending true за възходящ ред по цена, false за низходящ.
+ * @return Позициите на съвпадащите имоти; при еднаква цена - в реда им в каталога.
+ */
+vector<uint32_t> findSlotsByRooms(const PropertyStore& store, int roomsCount, bool sortAscending) {
+    return Query::rooms(roomsCount, roomsCount).findSlotsByPrice(store, sortAscending);
+}
+
+/**
+ * @brief Подканва за интервал по едно поле и го добавя към условията, ако потребителят потвърди.
+ */
+static void promptRangeCondition(RangeField field, const char* promptKey, vector<RangeCondition>& conditions) {
+    if (!getConfirmation((getTranslatedString(promptKey) + " [y/n]: ").c_str())) {
+        return;
+    }
+
+    while (true) {
+        double low = getValidNumericInput<double>((CYAN + getTranslatedString("PROMPT_RANGE_MIN") + RESET).c_str());
+        double high = getValidNumericInput<double>((CYAN + getTranslatedString("PROMPT_RANGE_MAX") + RESET).c_str());
+        if (low <= high) {
+            conditions.push_back({field, low, high});
+            return;
         }
+        cout << RED << getTranslatedString("ERROR_RANGE_MIN_GREATER_THAN_MAX") << RESET << endl;
     }
+}
 
-    
-    if (!isFound) {
-        cout << RED << getTranslatedString("NO_PROPERTIES_FOUND_FOR_ROOMS_COUNT_PART1") << " " << roomsCount << " " << getTranslatedString("NO_PROPERTIES_FOUND_FOR_ROOMS_COUNT_PART2") << RESET << endl;
+/**
+ * @brief Търси и показва имоти по интервали от стойности на цена, обща площ, етаж и брой стаи.
+ *
+ * Условията се събират поле по поле, след което позициите се намират чрез `findSlotsInRanges`
+ * и имотите се показват в получения ред (по цена, възходящо).
+ *
+ * @param store Контейнерът с имоти за търсене.
+ */
+void searchByRanges(const PropertyStore& store) {
+    if (store.empty()) {
+        cout << YELLOW << getTranslatedString("NO_PROPERTIES_IN_SYSTEM") << RESET << endl;
         return;
     }
 
-    
-    sortPropertiesArray(tempProperties, tempCount, false);
-    
-    cout << YELLOW << "\n--- " << getTranslatedString("SEARCH_RESULTS_FOR_ROOMS_COUNT_PART1") << " " << roomsCount << " " << getTranslatedString("SEARCH_RESULTS_FOR_ROOMS_COUNT_PART2") << " (" << getTranslatedString("SORTED_BY_PRICE") << ") ---" << RESET << endl;
-    
-    for (int i = 0; i < tempCount; i++) {
-        cout << YELLOW << "--- " << getTranslatedString("PROPERTY_HEADER") << " #" << i + 1 << RESET << endl;
-        displayPropertyDetails(tempProperties[i]);
+    vector<RangeCondition> conditions;
+    promptRangeCondition(RANGE_PRICE, "PROMPT_RANGE_FILTER_PRICE", conditions);
+    promptRangeCondition(RANGE_TOTAL_AREA, "PROMPT_RANGE_FILTER_TOTAL_AREA", conditions);
+    promptRangeCondition(RANGE_FLOOR, "PROMPT_RANGE_FILTER_FLOOR", conditions);
+    promptRangeCondition(RANGE_ROOMS, "PROMPT_RANGE_FILTER_ROOMS", conditions);
+
+    vector<uint32_t> slots = findSlotsInRanges(store, conditions);
+    if (slots.empty()) {
+        cout << RED << getTranslatedString("NO_PROPERTIES_FOUND_IN_RANGES") << RESET << endl;
+        return;
+    }
+
+    cout << YELLOW << "\n--- " << getTranslatedString("SEARCH_RESULTS_IN_RANGES") << " (" << getTranslatedString("SORTED_BY_PRICE") << ") ---" << RESET << endl;
+
+    displayPropertyList(store, slots);
+}
+
+/**
+ * @brief Превежда условие по интервал в заявка.
+ */
+static Query rangeQuery(const RangeCondition& condition) {
+    switch (condition.field) {
+        case RANGE_PRICE: return Query::price(condition.low, condition.high);
+        case RANGE_TOTAL_AREA: return Query::totalArea(condition.low, condition.high);
+        case RANGE_FLOOR: return Query::floor(condition.low, condition.high);
+        default: return Query::rooms(condition.low, condition.high);
+    }
+}
+
+/**
+ * @brief Намира позициите на имотите, които отговарят на всички условия, подредени по цена във възходящ ред.
+ *
+ * Условията се съчетават с И в една заявка и се изпълняват чрез `Query::findSlotsByPrice`:
+ * позициите се вземат от индекса на условието с най-малко съвпадения, а останалите условия
+ * се проверяват по колоните.
+ *
+ * @param store Контейнерът с имоти, в който да се търси.
+ * @param conditions Условията; без условия се връщат всички имоти.
+ * @return Позициите на съвпадащите имоти; при еднаква цена - в реда им в каталога.
+ */
+vector<uint32_t> findSlotsInRanges(const PropertyStore& store, const vector<RangeCondition>& conditions) {
+    if (conditions.empty()) {
+        return Query::all().findSlotsByPrice(store, true);
+    }
+    Query query = rangeQuery(conditions[0]);
+    for (size_t i = 1; i < conditions.size(); i++) {
+        query = query && rangeQuery(conditions[i]);
     }
+    return query.findSlotsByPrice(store, true);
 }
@@ -0,0 +1,144 @@
+/**
+ * @file sketch.cpp
+ * @brief Имплементация на скицата за приблизителни квантили, декларирана в `sketch.h`.
+ */
+
+#include <algorithm>
+#include <utility>
+
+#include "sketch.h"
+
+using namespace std;
+
+QuantileSketch::QuantileSketch(int k)
+    : k(max(2, k)), total(0), retained(0), maxRetained(0), promoteOdd(false), minimum(0.0), maximum(0.0) {
+}
+
+/**
+ * Капацитетът намалява геометрично с коефициент 2/3 от най-горното ниво надолу,
+ * но е поне 2, за да може всяко пълно ниво да бъде компактирано.
+ */
+size_t QuantileSketch::levelCapacity(size_t level) const {
+    size_t depth = levels.size() - 1 - level;
+    return max((size_t)2, (size_t)ceil(k * pow(2.0 / 3.0, (double)depth)));
+}
+
+void QuantileSketch::addLevel() {
+    levels.emplace_back();
+    maxRetained = 0;
+    for (size_t level = 0; level < levels.size(); level++) {
+        maxRetained += levelCapacity(level);
+    }
+}
+
+/**
+ * Компактира най-ниското пълно ниво: то се сортира и от всяка двойка съседни стойности
+ * една се премества на следващото ниво с двойно тегло. При нечетен брой най-голямата
+ * стойност остава на нивото, така че общото тегло се запазва точно.
+ */
+void QuantileSketch::compress() {
+    while (retained >= maxRetained) {
+        size_t level = 0;
+        while (levels[level].size() < levelCapacity(level)) {
+            level++;
+        }
+        if (level + 1 == levels.size()) {
+            addLevel();
+        }
+
+        vector<double>& items = levels[level];
+        sort(items.begin(), items.end());
+        size_t pairs = items.size() / 2;
+        vector<double>& next = levels[level + 1];
+        for (size_t i = 0; i < pairs; i++) {
+            next.push_back(items[2 * i + (promoteOdd ? 1 : 0)]);
+        }
+        promoteOdd = !promoteOdd;
+
+        if (items.size() % 2 == 1) {
+            items[0] = items.back();
+            items.resize(1);
+        } else {
+            items.clear();
+        }
+        retained -= pairs;
+    }
+}
+
+void QuantileSketch::add(double value) {
+    if (levels.empty()) {
+        addLevel();
+    }
+    minimum = total == 0 ? value : min(minimum, value);
+    maximum = total == 0 ? value : max(maximum, value);
+    levels[0].push_back(value);
+    total++;
+    retained++;
+    if (retained >= maxRetained) {
+        compress();
+    }
+}
+
+QuantileSketch& QuantileSketch::operator+=(const QuantileSketch& other) {
+    if (other.total == 0) {
+        return *this;
+    }
+    if (total == 0) {
+        *this = other;
+        return *this;
+    }
+
+    while (levels.size() < other.levels.size()) {
+        addLevel();
+    }
+    for (size_t level = 0; level < other.levels.size(); level++) {
+        levels[level].insert(levels[level].end(), other.levels[level].begin(), other.levels[level].end());
+    }
+    minimum = min(minimum, other.minimum);
+    maximum = max(maximum, other.maximum);
+    total += other.total;
+    retained += other.retained;
+    if (retained >= maxRetained) {
+        compress();
+    }
+    return *this;
+}
+
+uint64_t QuantileSketch::count() const {
+    return total;
+}
+
+/**
+ * Стойностите от всички нива се подреждат заедно с теглата си и се търси първата,
+ * при която натрупаното тегло достига търсения ранг.
+ */
+double QuantileSketch::quantile(double fraction) const {
+    if (total == 0) {
+        return 0.0;
+    }
+    uint64_t rank = quantileRank(fraction, total);
+    if (rank == 1) {
+        return minimum;
+    }
+    if (rank == total) {
+        return maximum;
+    }
+
+    vector<pair<double, uint64_t>> weighted;
+    weighted.reserve(retained);
+    for (size_t level = 0; level < levels.size(); level++) {
+        for (double value : levels[level]) {
+            weighted.push_back({value, (uint64_t)1 << level});
+        }
+    }
+    sort(weighted.begin(), weighted.end());
+
+    uint64_t cumulative = 0;
+    for (const pair<double, uint64_t>& item : weighted) {
+        cumulative += item.second;
+        if (cumulative >= rank) {
+            return item.first;
+        }
+    }
+    return maximum;
+}
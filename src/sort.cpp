@@ -1,114 +1,148 @@
 /**
  * @file sort.cpp
- * @brief Имплементация на алгоритъма Quicksort за сортиране на масив от структури Property.
+ * @brief Имплементация на сортирането на имоти чрез пермутация на позициите им.
  *
- * Този файл предоставя конкретната имплементация за сортиране на данни за имоти
- * въз основа на полето `price`, във възходящ или низходящ ред.
- * Той включва основната функция за сортиране `sortPropertiesArray` и нейните
- * помощни функции: `swap`, `partition` и рекурсивната `quickSort`.
+ * Алгоритмите (introsort и стабилно сортиране чрез сливане) са шаблони в `sort.h`,
+ * за да може компилаторът да вгради компаратора на всеки ключ. Тук се намират
+ * входните точки `sortSlotsByPrice`, която подрежда позиции на имоти по цена,
+ * и `sortSlotsByFields`, която ги подрежда по няколко полета.
  */
 
-#include <iostream> 
+#include <cstring>
+#include <numeric>
 
-#include "sort.h"    
-#include "structs.h" 
+#include "sort.h"
+#include "structs.h"
+#include "store.h"
 
 using namespace std;
 
+vector<uint32_t> dictionaryRanks(const StringDictionary& dictionary) {
+    vector<uint32_t> ids(dictionary.size());
+    iota(ids.begin(), ids.end(), 0u);
+    sort(ids.begin(), ids.end(), [&dictionary](uint32_t a, uint32_t b) { return strcmp(dictionary.lookup(a), dictionary.lookup(b)) < 0; });
+    vector<uint32_t> ranks(ids.size());
+    for (size_t rank = 0; rank < ids.size(); rank++) {
+        ranks[ids[rank]] = (uint32_t)rank;
+    }
+    return ranks;
+}
+
 /**
- * @brief Публична функция за иницииране на сортирането на масив от имоти.
- *
- * Тази функция служи като входна точка за сортиране. Тя проверява за базови случаи
- * (масив с 0 или 1 елемент вече е сортиран) и след това извиква рекурсивната
- * функция `quickSort` за извършване на действителната операция по сортиране. В момента
- * имотите се сортират въз основа на тяхната `price`.
- *
- * @param arr Масивът от структури `Property`, който ще бъде сортиран.
- * @param size Броят на елементите в масива.
- * @param sortAscending Булев флаг: `true` за сортиране във възходящ ред, `false` за низходящ.
+ * @brief Записва в `keys` кодирания ключ `encode(slot) ^ flip` на всяка позиция.
  */
-void sortPropertiesArray(struct Property arr[], int size, bool sortAscending) {
-    if (size <= 1) return; 
-
-    quickSort(arr, 0, size - 1, sortAscending); 
+template <typename Encode>
+static void encodeKeys(const vector<uint32_t>& slots, uint64_t flip, vector<uint64_t>& keys, Encode encode) {
+    keys.resize(slots.size());
+    for (size_t i = 0; i < slots.size(); i++) {
+        keys[i] = (uint64_t)encode(slots[i]) ^ flip;
+    }
 }
 
 /**
- * @brief Разменя местата на две структури `Property` в паметта.
- *
- * Тази помощна функция се използва от алгоритъма за сортиране за ефективна размяна
- * на позициите на два елемента.
- *
- * @param a Указател към първата структура `Property`.
- * @param b Указател към втората структура `Property`.
+ * @brief Кодира ключа на всяка позиция по един критерий (виж `sortSlotsByFields`).
  */
-void swap(struct Property* a, struct Property* b) {
-    Property temp = *a; 
-    *a = *b;            
-    *b = temp;          
+static void encodeCriterion(const PropertyStore& store, const vector<uint32_t>& slots, const SortCriterion& criterion,
+                            vector<uint64_t>& keys) {
+    uint64_t flip = criterion.ascending ? 0 : ~(uint64_t)0;
+    const StringDictionary* dictionary = NULL;
+    const uint32_t* ids = NULL;
+    switch (criterion.field) {
+        case SORT_FIELD_REF_NUMBER: {
+            const int* refNumbers = store.refNumbers();
+            encodeKeys(slots, flip, keys, [refNumbers](uint32_t slot) { return radixKey(refNumbers[slot]); });
+            return;
+        }
+        case SORT_FIELD_PRICE: {
+            const double* prices = store.prices();
+            encodeKeys(slots, flip, keys, [prices](uint32_t slot) { return radixKey(prices[slot]); });
+            return;
+        }
+        case SORT_FIELD_TOTAL_AREA: {
+            const double* totalAreas = store.totalAreas();
+            encodeKeys(slots, flip, keys, [totalAreas](uint32_t slot) { return radixKey(totalAreas[slot]); });
+            return;
+        }
+        case SORT_FIELD_ROOMS: {
+            const int* rooms = store.rooms();
+            encodeKeys(slots, flip, keys, [rooms](uint32_t slot) { return radixKey(rooms[slot]); });
+            return;
+        }
+        case SORT_FIELD_FLOOR: {
+            const int* floors = store.floors();
+            encodeKeys(slots, flip, keys, [floors](uint32_t slot) { return radixKey(floors[slot]); });
+            return;
+        }
+        case SORT_FIELD_STATUS: {
+            const unsigned char* statuses = store.statuses();
+            encodeKeys(slots, flip, keys, [statuses](uint32_t slot) { return statuses[slot]; });
+            return;
+        }
+        case SORT_FIELD_BROKER: dictionary = &store.brokers(); ids = store.brokerIds(); break;
+        case SORT_FIELD_TYPE: dictionary = &store.types(); ids = store.typeIds(); break;
+        case SORT_FIELD_AREA: dictionary = &store.areas(); ids = store.areaIds(); break;
+        default: dictionary = &store.expositions(); ids = store.expositionIds(); break;
+    }
+    vector<uint32_t> ranks = dictionaryRanks(*dictionary);
+    encodeKeys(slots, flip, keys, [&ranks, ids](uint32_t slot) { return ranks[ids[slot]]; });
 }
 
 /**
- * @brief Разделя подмасив около елемент на опора като част от алгоритъма Quicksort.
- *
- * Тази функция избира последния елемент за опора. Тя пренарежда елементите
- * в подмасива така, че всички елементи, удовлетворяващи условието за сортиране (напр.
- * по-малки от опората за възходящо сортиране) идват преди опората, а всички елементи,
- * които не удовлетворяват условието, идват след нея. Окончателната позиция на опората
- * след това се връща.
- *
- * @param arr Масивът от структури `Property`, който ще бъде разделен.
- * @param low Началният индекс на подмасива за разделяне.
- * @param high Крайният индекс на подмасива за разделяне.
- * @param sortAscending Булев флаг, указващ посоката на сортиране (`true` за възходящ).
- * @return Индексът на елемента на опора след разделянето.
+ * @brief Сортира позициите по вече кодираните ключове с компаратор за `KeyCount` критерия.
  */
-int partition(struct Property arr[], int low, int high, bool sortAscending) {
-    double pivotPrice = arr[high].price; 
-    int i = (low - 1); 
+template <int KeyCount>
+static void sortEncoded(vector<uint32_t>& slots, const vector<vector<uint64_t>>& keys, bool stable) {
+    vector<EncodedSlot<KeyCount>> items(slots.size());
+    for (size_t i = 0; i < slots.size(); i++) {
+        for (int key = 0; key < KeyCount; key++) {
+            items[i].keys[key] = keys[key][i];
+        }
+        items[i].slot = slots[i];
+    }
 
-    
-    for (int j = low; j <= high - 1; j++) {
-        bool condition;
+    EncodedSlot<KeyCount>* first = items.data();
+    EncodedSlot<KeyCount>* last = first + items.size();
+    if (stable) {
+        stableSort(first, last, EncodedKeysLess<KeyCount>());
+    } else {
+        introSort(first, last, EncodedKeysLess<KeyCount>());
+    }
 
-        
-        if (sortAscending) {
-            condition = (arr[j].price < pivotPrice); 
-        } else {
-            condition = (arr[j].price > pivotPrice); 
-        }
+    for (size_t i = 0; i < items.size(); i++) {
+        slots[i] = items[i].slot;
+    }
+}
 
-        
-        if (condition) {
-            i++;
-            swap(&arr[i], &arr[j]);
-        }
+void sortSlotsByFields(const PropertyStore& store, vector<uint32_t>& slots, const vector<SortCriterion>& criteria, bool stable) {
+    if (slots.size() <= 1 || criteria.empty()) return;
+
+    size_t count = min(criteria.size(), (size_t)MAX_SORT_CRITERIA);
+    vector<vector<uint64_t>> keys(count);
+    for (size_t i = 0; i < count; i++) {
+        encodeCriterion(store, slots, criteria[i], keys[i]);
     }
 
-    swap(&arr[i + 1], &arr[high]); 
-    return (i + 1); 
+    switch (count) {
+        case 1: sortEncoded<1>(slots, keys, stable); break;
+        case 2: sortEncoded<2>(slots, keys, stable); break;
+        case 3: sortEncoded<3>(slots, keys, stable); break;
+        default: sortEncoded<4>(slots, keys, stable); break;
+    }
 }
 
 /**
- * @brief Рекурсивна имплементация на алгоритъма Quicksort.
+ * @brief Публична функция за подреждане на позиции на имоти по цена.
  *
- * Тази функция сортира подмасив от структури `Property` на място. Тя работи чрез
- * разделяне на масива около елемент на опора и след това рекурсивно извикване
- * на себе си за подмасивите преди и след опората. Базовият случай на рекурсията
- * е, когато подмасивът има 0 или 1 елемент.
+ * Цените се вземат направо от колоната на контейнера, така че за всеки имот се
+ * копират само 8 байта цена и 4 байта позиция вместо цялата структура `Property`.
  *
- * @param arr Масивът от структури `Property`, който ще бъде сортиран.
- * @param low Началният индекс на подмасива.
- * @param high Крайният индекс на подмасива.
- * @param sortAscending Булев флаг, указващ посоката на сортиране.
+ * @param store Контейнерът, от който се вземат цените.
+ * @param slots Позициите, които да бъдат пренаредени.
+ * @param sortAscending Булев флаг: `true` за сортиране във възходящ ред, `false` за низходящ.
+ * @param threadCount Брой нишки; 0 избира автоматично според броя на позициите и ядрата.
  */
-void quickSort(struct Property arr[], int low, int high, bool sortAscending) {
-    if (low >= high) return; 
-
-    
-    int pi = partition(arr, low, high, sortAscending);
+void sortSlotsByPrice(const PropertyStore& store, vector<uint32_t>& slots, bool sortAscending, int threadCount) {
+    if (slots.size() <= 1) return;
 
-    
-    quickSort(arr, low, pi - 1, sortAscending);   
-    quickSort(arr, pi + 1, high, sortAscending); 
+    sortSlotsByKey(slots.data(), slots.data() + slots.size(), store.prices(), sortAscending, threadCount);
 }
@@ -0,0 +1,516 @@
+/**
+ * @file store.cpp
+ * @brief Имплементация на контейнера PropertyStore.
+ *
+ * Всяко поле на имота се съхранява в отделен `std::vector` (колона), което позволява
+ * неограничен растеж, предварително заделяне на памет при зареждане на големи каталози
+ * и последователно четене само на нужните полета при агрегиращи обхождания.
+ * Текстовите полета се кодират чрез речници и в колоните се пазят само идентификатори.
+ * Всички методи, които променят имотите, поддържат и индекса по референтен номер.
+ */
+
+#include <cstring>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+
+#include "store.h"
+#include "sort.h"
+#include "sketch.h"
+
+using namespace std;
+
+/**
+ * @brief Копира C-стил низ в буфер с фиксиран размер, гарантирайки терминираща нула.
+ */
+static void copyText(char* destination, const char* source, size_t size) {
+    strncpy(destination, source, size - 1);
+    destination[size - 1] = '\0';
+}
+
+/**
+ * @brief Пренарежда колона според дадена пермутация.
+ */
+template <typename T>
+static void permuteColumn(vector<T>& column, const vector<uint32_t>& order) {
+    vector<T> reordered;
+    reordered.reserve(column.size());
+    for (uint32_t slot : order) {
+        reordered.push_back(column[slot]);
+    }
+    column.swap(reordered);
+}
+
+int PropertyStore::size() const {
+    return (int)refNumberColumn.size();
+}
+
+bool PropertyStore::empty() const {
+    return refNumberColumn.empty();
+}
+
+void PropertyStore::reserve(int capacity) {
+    if (capacity > 0) {
+        refNumberColumn.reserve(capacity);
+        priceColumn.reserve(capacity);
+        totalAreaColumn.reserve(capacity);
+        roomsColumn.reserve(capacity);
+        floorColumn.reserve(capacity);
+        statusColumn.reserve(capacity);
+        brokerColumn.reserve(capacity);
+        typeColumn.reserve(capacity);
+        areaColumn.reserve(capacity);
+        expositionColumn.reserve(capacity);
+        refIndex.reserve(capacity);
+    }
+}
+
+void PropertyStore::clear() {
+    refNumberColumn.clear();
+    priceColumn.clear();
+    totalAreaColumn.clear();
+    roomsColumn.clear();
+    floorColumn.clear();
+    statusColumn.clear();
+    brokerColumn.clear();
+    typeColumn.clear();
+    areaColumn.clear();
+    expositionColumn.clear();
+    brokerDictionary.clear();
+    typeDictionary.clear();
+    areaDictionary.clear();
+    expositionDictionary.clear();
+    refIndex.clear();
+    brokerIndex.clear();
+    roomsIndex.clear();
+    areaIndex.clear();
+    areaPriceSums.clear();
+    for (SortedSlotList& rangeIndex : rangeIndexes) {
+        rangeIndex.clear();
+    }
+}
+
+/**
+ * @brief Дописва полетата на имота в колоните и в индекса по референтен номер.
+ * @return Позицията на новия имот.
+ */
+int PropertyStore::pushColumns(const Property& property) {
+    refNumberColumn.push_back(property.refNumber);
+    priceColumn.push_back(property.price);
+    totalAreaColumn.push_back(property.totalArea);
+    roomsColumn.push_back(property.rooms);
+    floorColumn.push_back(property.floor);
+    statusColumn.push_back((unsigned char)property.status);
+    brokerColumn.push_back(brokerDictionary.intern(property.broker));
+    typeColumn.push_back(typeDictionary.intern(property.type));
+    areaColumn.push_back(areaDictionary.intern(property.area));
+    expositionColumn.push_back(expositionDictionary.intern(property.exposition));
+
+    int slot = size() - 1;
+    refIndex.insert(property.refNumber, slot);
+    addToAreaSum(areaColumn[slot], property.price);
+    return slot;
+}
+
+bool PropertyStore::isStorable(const Property& property) {
+    return isfinite(property.price) && isfinite(property.totalArea);
+}
+
+int PropertyStore::add(const Property& property) {
+    if (!isStorable(property)) {
+        return -1;
+    }
+    int slot = pushColumns(property);
+    brokerIndex.insert(brokerColumn[slot], property.price, slot);
+    roomsIndex.insert((uint32_t)property.rooms, property.price, slot);
+    areaIndex.insert(areaColumn[slot], property.price, slot);
+    for (int field = 0; field < RANGE_FIELD_COUNT; field++) {
+        rangeIndexes[field].place(rangeKey(field, slot), slot);
+    }
+    return slot;
+}
+
+int PropertyStore::append(const Property& property) {
+    if (!isStorable(property)) {
+        return -1;
+    }
+    int slot = pushColumns(property);
+    brokerIndex.append(brokerColumn[slot], property.price, slot);
+    roomsIndex.append((uint32_t)property.rooms, property.price, slot);
+    areaIndex.append(areaColumn[slot], property.price, slot);
+    for (int field = 0; field < RANGE_FIELD_COUNT; field++) {
+        rangeIndexes[field].append(rangeKey(field, slot), slot);
+    }
+    return slot;
+}
+
+void PropertyStore::finishAppend() {
+    brokerIndex.finishAppend();
+    roomsIndex.finishAppend();
+    areaIndex.finishAppend();
+    for (SortedSlotList& rangeIndex : rangeIndexes) {
+        rangeIndex.finishAppend();
+    }
+}
+
+/**
+ * Следващите имоти се изместват с една позиция напред, за да се запази редът им,
+ * затова позициите в индекса също се коригират.
+ */
+void PropertyStore::remove(int slot) {
+    if (refIndex.find(refNumberColumn[slot]) == slot) {
+        refIndex.erase(refNumberColumn[slot]);
+    }
+    brokerIndex.erase(brokerColumn[slot], priceColumn[slot], slot);
+    roomsIndex.erase((uint32_t)roomsColumn[slot], priceColumn[slot], slot);
+    areaIndex.erase(areaColumn[slot], priceColumn[slot], slot);
+    removeFromAreaSum(areaColumn[slot], priceColumn[slot]);
+    for (int field = 0; field < RANGE_FIELD_COUNT; field++) {
+        rangeIndexes[field].erase(rangeKey(field, slot), slot);
+    }
+    refNumberColumn.erase(refNumberColumn.begin() + slot);
+    priceColumn.erase(priceColumn.begin() + slot);
+    totalAreaColumn.erase(totalAreaColumn.begin() + slot);
+    roomsColumn.erase(roomsColumn.begin() + slot);
+    floorColumn.erase(floorColumn.begin() + slot);
+    statusColumn.erase(statusColumn.begin() + slot);
+    brokerColumn.erase(brokerColumn.begin() + slot);
+    typeColumn.erase(typeColumn.begin() + slot);
+    areaColumn.erase(areaColumn.begin() + slot);
+    expositionColumn.erase(expositionColumn.begin() + slot);
+    refIndex.shiftSlotsAfter(slot);
+    brokerIndex.shiftSlotsAfter(slot);
+    roomsIndex.shiftSlotsAfter(slot);
+    areaIndex.shiftSlotsAfter(slot);
+    for (SortedSlotList& rangeIndex : rangeIndexes) {
+        rangeIndex.shiftSlotsAfter(slot);
+    }
+}
+
+Property PropertyStore::get(int slot) const {
+    Property property;
+    property.refNumber = refNumberColumn[slot];
+    property.price = priceColumn[slot];
+    property.totalArea = totalAreaColumn[slot];
+    property.rooms = roomsColumn[slot];
+    property.floor = floorColumn[slot];
+    property.status = (Status)statusColumn[slot];
+    copyText(property.broker, brokerDictionary.lookup(brokerColumn[slot]), sizeof(property.broker));
+    copyText(property.type, typeDictionary.lookup(typeColumn[slot]), sizeof(property.type));
+    copyText(property.area, areaDictionary.lookup(areaColumn[slot]), sizeof(property.area));
+    copyText(property.exposition, expositionDictionary.lookup(expositionColumn[slot]), sizeof(property.exposition));
+    return property;
+}
+
+PropertyView PropertyStore::view(int slot) const {
+    PropertyView property;
+    property.refNumber = refNumberColumn[slot];
+    property.broker = brokerDictionary.lookup(brokerColumn[slot]);
+    property.type = typeDictionary.lookup(typeColumn[slot]);
+    property.area = areaDictionary.lookup(areaColumn[slot]);
+    property.exposition = expositionDictionary.lookup(expositionColumn[slot]);
+    property.price = priceColumn[slot];
+    property.totalArea = totalAreaColumn[slot];
+    property.rooms = roomsColumn[slot];
+    property.floor = floorColumn[slot];
+    property.status = (Status)statusColumn[slot];
+    return property;
+}
+
+bool PropertyStore::update(int slot, const Property& property) {
+    if (!isStorable(property)) {
+        return false;
+    }
+    if (refNumberColumn[slot] != property.refNumber) {
+        refIndex.erase(refNumberColumn[slot]);
+        refIndex.insert(property.refNumber, slot);
+    }
+    uint32_t oldBrokerId = brokerColumn[slot];
+    int oldRooms = roomsColumn[slot];
+    uint32_t oldAreaId = areaColumn[slot];
+    double oldPrice = priceColumn[slot];
+    double oldRangeKeys[RANGE_FIELD_COUNT];
+    for (int field = 0; field < RANGE_FIELD_COUNT; field++) {
+        oldRangeKeys[field] = rangeKey(field, slot);
+    }
+    refNumberColumn[slot] = property.refNumber;
+    priceColumn[slot] = property.price;
+    totalAreaColumn[slot] = property.totalArea;
+    roomsColumn[slot] = property.rooms;
+    floorColumn[slot] = property.floor;
+    statusColumn[slot] = (unsigned char)property.status;
+    brokerColumn[slot] = brokerDictionary.intern(property.broker);
+    typeColumn[slot] = typeDictionary.intern(property.type);
+    areaColumn[slot] = areaDictionary.intern(property.area);
+    expositionColumn[slot] = expositionDictionary.intern(property.exposition);
+
+    if (brokerColumn[slot] != oldBrokerId || priceColumn[slot] != oldPrice) {
+        brokerIndex.move(oldBrokerId, oldPrice, brokerColumn[slot], priceColumn[slot], slot);
+    }
+    if (roomsColumn[slot] != oldRooms || priceColumn[slot] != oldPrice) {
+        roomsIndex.move((uint32_t)oldRooms, oldPrice, (uint32_t)roomsColumn[slot], priceColumn[slot], slot);
+    }
+    if (areaColumn[slot] != oldAreaId || priceColumn[slot] != oldPrice) {
+        areaIndex.move(oldAreaId, oldPrice, areaColumn[slot], priceColumn[slot], slot);
+        removeFromAreaSum(oldAreaId, oldPrice);
+        addToAreaSum(areaColumn[slot], priceColumn[slot]);
+    }
+    for (int field = 0; field < RANGE_FIELD_COUNT; field++) {
+        double newKey = rangeKey(field, slot);
+        if (newKey != oldRangeKeys[field]) {
+            rangeIndexes[field].erase(oldRangeKeys[field], slot);
+            rangeIndexes[field].place(newKey, slot);
+        }
+    }
+    return true;
+}
+
+int PropertyStore::findByRefNumber(int refNumber) const {
+    return refIndex.find(refNumber);
+}
+
+vector<uint32_t> PropertyStore::findByBroker(uint32_t brokerId, bool sortAscending) const {
+    return brokerIndex.collect(brokerId, sortAscending);
+}
+
+size_t PropertyStore::countByBroker(uint32_t brokerId) const {
+    return brokerIndex.count(brokerId);
+}
+
+vector<uint32_t> PropertyStore::findInRange(RangeField field, double low, double high) const {
+    return rangeIndexes[field].collectRange(low, high);
+}
+
+size_t PropertyStore::countInRange(RangeField field, double low, double high) const {
+    return rangeIndexes[field].countRange(low, high);
+}
+
+vector<uint32_t> PropertyStore::findTop(RangeField field, size_t count, bool largest) const {
+    return rangeIndexes[field].collect(!largest, count);
+}
+
+AreaAggregate PropertyStore::areaAggregate(uint32_t areaId) const {
+    AreaAggregate aggregate = {0, 0.0, -1};
+    aggregate.count = (int)areaIndex.count(areaId);
+    if (aggregate.count > 0) {
+        aggregate.totalPrice = areaPriceSums[areaId];
+        aggregate.mostExpensiveSlot = areaIndex.largestSlot(areaId);
+    }
+    return aggregate;
+}
+
+vector<uint32_t> PropertyStore::findByArea(uint32_t areaId, bool sortAscending, size_t limit) const {
+    return areaIndex.collect(areaId, sortAscending, limit);
+}
+
+double PropertyStore::areaPriceQuantile(uint32_t areaId, double fraction) const {
+    size_t count = areaIndex.count(areaId);
+    if (count == 0) {
+        return 0.0;
+    }
+    return areaIndex.keyAt(areaId, quantileRank(fraction, count) - 1);
+}
+
+/**
+ * Стойностите се изчисляват наново с едно обхождане на колоните и се сравняват
+ * за всеки идентификатор в речника на районите. Неизчислима цена или площ в
+ * колоните, както и неизчислима поддържана сума, също е несъответствие: `fabs`
+ * от NaN не е по-голямо от допустимата грешка и иначе би минало незабелязано.
+ */
+bool PropertyStore::verifyAreaAggregates() const {
+    int areaCount = areaDictionary.size();
+    vector<int> counts(areaCount, 0);
+    vector<double> sums(areaCount, 0.0);
+    vector<int> mostExpensive(areaCount, -1);
+    for (int i = 0; i < size(); i++) {
+        if (!isfinite(priceColumn[i]) || !isfinite(totalAreaColumn[i])) {
+            return false;
+        }
+        uint32_t areaId = areaColumn[i];
+        counts[areaId]++;
+        sums[areaId] += priceColumn[i];
+        if (mostExpensive[areaId] == -1 || priceColumn[i] > priceColumn[mostExpensive[areaId]]) {
+            mostExpensive[areaId] = i;
+        }
+    }
+
+    for (int areaId = 0; areaId < areaCount; areaId++) {
+        AreaAggregate aggregate = areaAggregate((uint32_t)areaId);
+        double tolerance = 1e-9 * max(1.0, fabs(sums[areaId]));
+        if (aggregate.count != counts[areaId] || !(fabs(aggregate.totalPrice - sums[areaId]) <= tolerance) ||
+            aggregate.mostExpensiveSlot != mostExpensive[areaId]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Сумата се поддържа в масив, индексиран с идентификатора на района. Неизчислима
+ * цена не се добавя: един NaN би направил сумата NaN завинаги, защото изваждането
+ * не го премахва. `isStorable()` вече не пропуска такива имоти; проверката тук
+ * пази сумата и ако това условие бъде нарушено.
+ */
+void PropertyStore::addToAreaSum(uint32_t areaId, double price) {
+    if (areaId >= areaPriceSums.size()) {
+        areaPriceSums.resize(areaId + 1, 0.0);
+    }
+    if (isfinite(price)) {
+        areaPriceSums[areaId] += price;
+    }
+}
+
+/**
+ * Когато в района не остане нито един имот, сумата се нулира точно, за да не се
+ * натрупва грешка от закръгляване при многократно добавяне и изваждане.
+ */
+void PropertyStore::removeFromAreaSum(uint32_t areaId, double price) {
+    if (isfinite(price)) {
+        areaPriceSums[areaId] -= price;
+    }
+    if (areaIndex.count(areaId) == 0) {
+        areaPriceSums[areaId] = 0.0;
+    }
+}
+
+/**
+ * @brief Връща стойността на имота на позиция `slot` за полето `field` от `RangeField`.
+ *
+ * Целочислените полета (етаж и брой стаи) се представят точно като `double`.
+ */
+double PropertyStore::rangeKey(int field, int slot) const {
+    switch (field) {
+        case RANGE_PRICE: return priceColumn[slot];
+        case RANGE_TOTAL_AREA: return totalAreaColumn[slot];
+        case RANGE_FLOOR: return floorColumn[slot];
+        default: return roomsColumn[slot];
+    }
+}
+
+/**
+ * Броят стаи се използва като ключ в `PostingIndex` след преобразуване към `uint32_t`,
+ * което запазва различните стойности различни.
+ */
+vector<uint32_t> PropertyStore::findByRooms(int roomsCount, bool sortAscending) const {
+    return roomsIndex.collect((uint32_t)roomsCount, sortAscending);
+}
+
+/**
+ * Сортира се само масив от 32-битови позиции заедно с цените им (чрез `sortSlotsByPrice`),
+ * след което колоните се пренареждат наведнъж според получената пермутация. Имотите
+ * с еднаква цена запазват реда си. Вече сортиран каталог се разпознава с едно обхождане.
+ */
+void PropertyStore::sortByPrice(bool sortAscending) {
+    vector<uint32_t> order(size());
+    iota(order.begin(), order.end(), 0u);
+    sortSlotsByPrice(*this, order, sortAscending);
+
+    permute(order);
+}
+
+void PropertyStore::sortByFields(const vector<SortCriterion>& criteria, bool stable) {
+    vector<uint32_t> order(size());
+    iota(order.begin(), order.end(), 0u);
+    sortSlotsByFields(*this, order, criteria, stable);
+
+    permute(order);
+}
+
+/**
+ * @brief Пренарежда всички колони така, че новата позиция `i` съдържа имота от позиция `order[i]`.
+ */
+void PropertyStore::permute(const vector<uint32_t>& order) {
+    permuteColumn(refNumberColumn, order);
+    permuteColumn(priceColumn, order);
+    permuteColumn(totalAreaColumn, order);
+    permuteColumn(roomsColumn, order);
+    permuteColumn(floorColumn, order);
+    permuteColumn(statusColumn, order);
+    permuteColumn(brokerColumn, order);
+    permuteColumn(typeColumn, order);
+    permuteColumn(areaColumn, order);
+    permuteColumn(expositionColumn, order);
+    rebuildIndexes();
+}
+
+/**
+ * Използва се след операции, които пренареждат всички имоти наведнъж.
+ */
+void PropertyStore::rebuildIndexes() {
+    refIndex.clear();
+    refIndex.reserve(size());
+    brokerIndex.clear();
+    roomsIndex.clear();
+    areaIndex.clear();
+    areaPriceSums.clear();
+    for (SortedSlotList& rangeIndex : rangeIndexes) {
+        rangeIndex.clear();
+    }
+    for (int i = 0; i < size(); i++) {
+        refIndex.insert(refNumberColumn[i], i);
+        brokerIndex.append(brokerColumn[i], priceColumn[i], i);
+        roomsIndex.append((uint32_t)roomsColumn[i], priceColumn[i], i);
+        areaIndex.append(areaColumn[i], priceColumn[i], i);
+        addToAreaSum(areaColumn[i], priceColumn[i]);
+        for (int field = 0; field < RANGE_FIELD_COUNT; field++) {
+            rangeIndexes[field].append(rangeKey(field, i), i);
+        }
+    }
+    finishAppend();
+}
+
+const int* PropertyStore::refNumbers() const {
+    return refNumberColumn.data();
+}
+
+const double* PropertyStore::prices() const {
+    return priceColumn.data();
+}
+
+const double* PropertyStore::totalAreas() const {
+    return totalAreaColumn.data();
+}
+
+const int* PropertyStore::rooms() const {
+    return roomsColumn.data();
+}
+
+const int* PropertyStore::floors() const {
+    return floorColumn.data();
+}
+
+const unsigned char* PropertyStore::statuses() const {
+    return statusColumn.data();
+}
+
+const uint32_t* PropertyStore::brokerIds() const {
+    return brokerColumn.data();
+}
+
+const uint32_t* PropertyStore::typeIds() const {
+    return typeColumn.data();
+}
+
+const uint32_t* PropertyStore::areaIds() const {
+    return areaColumn.data();
+}
+
+const uint32_t* PropertyStore::expositionIds() const {
+    return expositionColumn.data();
+}
+
+const StringDictionary& PropertyStore::brokers() const {
+    return brokerDictionary;
+}
+
+const StringDictionary& PropertyStore::types() const {
+    return typeDictionary;
+}
+
+const StringDictionary& PropertyStore::areas() const {
+    return areaDictionary;
+}
+
+const StringDictionary& PropertyStore::expositions() const {
+    return expositionDictionary;
+}
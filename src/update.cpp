@@ -16,7 +16,9 @@
 
 #include "update.h"    
 #include "structs.h"   
+#include "store.h"     
 #include "file.h"      
+#include "journal.h"   
 #include "colors.h"    
 #include "add.h"       
 #include "localization.h" 
@@ -30,14 +32,14 @@ using namespace std;
  * Тя първо подканва за референтен номер на имот, след което проверява неговото съществуване.
  * Ако имотът е намерен и не е маркиран като ПРОДАДЕН, тя представя меню от полета,
  * които могат да бъдат актуализирани. Въз основа на избора на потребителя, тя извиква съответната помощна
- * функция за модифициране на конкретното поле. След успешно актуализиране, данните се
+ * функция за модифициране на конкретното поле. Промените се правят върху копие на имота,
+ * което след успешно актуализиране се записва обратно в контейнера, а данните се
  * синхронизират за възстановяване.
  *
- * @param properties Масив от структури `Property`, където се намира имотът за актуализиране.
- * @param propertyCount Текущият брой валидни имоти в масива.
+ * @param store Контейнерът с имоти, където се намира имотът за актуализиране.
  */
-void updateProperty(Property properties[], int& propertyCount) {
-    if (propertyCount == 0) {
+void updateProperty(PropertyStore& store) {
+    if (store.empty()) {
         cout << YELLOW << getTranslatedString("NO_PROPERTIES_IN_SYSTEM") << RESET << endl;
         return;
     }
@@ -45,7 +47,7 @@ void updateProperty(Property properties[], int& propertyCount) {
     
     int refNumber = getValidNumericInput<int>((CYAN + getTranslatedString("PROMPT_REF_NUMBER_TO_UPDATE") + RESET).c_str());
     
-    int index = getPropertyByRefNumber(refNumber, properties, propertyCount);
+    int index = getPropertyByRefNumber(refNumber, store);
 
     if (index == -1) {
         cout << RED << getTranslatedString("ERROR_PROPERTY_NOT_FOUND_REF") << " - " << refNumber << "." << RESET << endl;
@@ -53,7 +55,8 @@ void updateProperty(Property properties[], int& propertyCount) {
     }
 
     
-    if (properties[index].status == SOLD) {
+    Property edited = store.get(index);
+    if (edited.status == SOLD) {
         cout << RED << getTranslatedString("ERROR_SOLD_PROPERTY_CANNOT_BE_EDITED") << RESET << endl;
         return;
     }
@@ -73,23 +76,23 @@ void updateProperty(Property properties[], int& propertyCount) {
 
     bool updateMade = false; 
     switch (choice) {
-        case 1: updateMade = updateRefNumber(properties, propertyCount, index); break;
-        case 2: updateMade = updateStringField(properties[index].broker, 50, getTranslatedString("BROKER_FIELD_NAME").c_str()); break;
-        case 3: updateMade = updateStringField(properties[index].type, 50, getTranslatedString("TYPE_FIELD_NAME").c_str()); break;
-        case 4: updateMade = updateStringField(properties[index].area, 50, getTranslatedString("AREA_FIELD_NAME").c_str()); break;
-        case 5: updateMade = updateStringField(properties[index].exposition, 20, getTranslatedString("EXPOSITION_FIELD_NAME").c_str()); break;
-        case 6: updateMade = updateNumericField(&properties[index].price, getTranslatedString("PRICE_FIELD_NAME").c_str()); break;
-        case 7: updateMade = updateNumericField(&properties[index].totalArea, getTranslatedString("TOTAL_AREA_FIELD_NAME").c_str()); break;
-        case 8: updateMade = updateNumericField(&properties[index].rooms, getTranslatedString("ROOMS_FIELD_NAME").c_str()); break;
-        case 9: updateMade = updateNumericField(&properties[index].floor, getTranslatedString("FLOOR_FIELD_NAME").c_str()); break;
-        case 10: updateMade = updateStatus(properties[index]); break;
+        case 1: updateMade = updateRefNumber(store, edited); break;
+        case 2: updateMade = updateStringField(edited.broker, 50, getTranslatedString("BROKER_FIELD_NAME").c_str()); break;
+        case 3: updateMade = updateStringField(edited.type, 50, getTranslatedString("TYPE_FIELD_NAME").c_str()); break;
+        case 4: updateMade = updateStringField(edited.area, 50, getTranslatedString("AREA_FIELD_NAME").c_str()); break;
+        case 5: updateMade = updateStringField(edited.exposition, 20, getTranslatedString("EXPOSITION_FIELD_NAME").c_str()); break;
+        case 6: updateMade = updateNumericField(&edited.price, getTranslatedString("PRICE_FIELD_NAME").c_str()); break;
+        case 7: updateMade = updateNumericField(&edited.totalArea, getTranslatedString("TOTAL_AREA_FIELD_NAME").c_str()); break;
+        case 8: updateMade = updateNumericField(&edited.rooms, getTranslatedString("ROOMS_FIELD_NAME").c_str()); break;
+        case 9: updateMade = updateNumericField(&edited.floor, getTranslatedString("FLOOR_FIELD_NAME").c_str()); break;
+        case 10: updateMade = updateStatus(edited); break;
         case 0: return; 
         default: cout << RED << getTranslatedString("INVALID_OPTION") << RESET << endl; break;
     }
 
     if (updateMade) {
         cout << GREEN << getTranslatedString("PROPERTY_DATA_UPDATED_SUCCESS") << RESET << endl;
-        syncDataToRecoveryFiles(properties, propertyCount); 
+        updatePropertyWithJournal(store, index, edited); 
     }
 }
 
@@ -97,19 +100,15 @@ void updateProperty(Property properties[], int& propertyCount) {
  * @brief Търси имот по неговия референтен номер.
  *
  * Тази помощна функция се използва от различни модули за локализиране на конкретен имот.
- * Тя итерира през масива от имоти и връща индекса на съвпадащия
- * имот. Ако не бъде намерен имот с дадения референтен номер, тя връща -1.
+ * Тя използва хеш индекса на контейнера, така че търсенето е със средна сложност O(1)
+ * независимо от броя на имотите. Ако не бъде намерен имот с дадения референтен номер, тя връща -1.
  *
  * @param refNumber Референтният номер на имота, който да се намери.
- * @param properties Постоянен масив от структури `Property` за търсене.
- * @param propertyCount Броят на валидните имоти в масива.
- * @return 0-базиран индекс на имота, ако е намерен; в противен случай -1.
+ * @param store Контейнерът с имоти за търсене.
+ * @return 0-базирана позиция на имота, ако е намерен; в противен случай -1.
  */
-int getPropertyByRefNumber(int refNumber, const Property properties[], int propertyCount) {
-    for (int i = 0; i < propertyCount; i++) {
-        if (properties[i].refNumber == refNumber) return i;
-    }
-    return -1; 
+int getPropertyByRefNumber(int refNumber, const PropertyStore& store) {
+    return store.findByRefNumber(refNumber);
 }
 
 /**
@@ -117,31 +116,30 @@ int getPropertyByRefNumber(int refNumber, const Property properties[], int prope
  *
  * Тази функция подканва потребителя за нов референтен номер. Тя проверява дали
  * новият референтен номер е различен от стария и, по-важното,
- * дали е уникален в рамките на съществуващия масив от имоти. Ако е валиден и уникален,
- * референтният номер на имота се актуализира.
+ * дали е уникален в рамките на съществуващия контейнер с имоти. Ако е валиден и уникален,
+ * референтният номер на редактираното копие се актуализира.
  *
- * @param properties Масив от структури `Property` (необходим за проверка на уникалност).
- * @param propertyCount Броят на валидните имоти в масива.
- * @param index Индексът на имота, чийто референтен номер трябва да бъде актуализиран.
+ * @param store Контейнерът с имоти (необходим за проверка на уникалност).
+ * @param propertyToUpdate Референция към копието на имота, чийто референтен номер трябва да бъде актуализиран.
  * @return `true`, ако референтният номер е успешно актуализиран; `false` в противен случай.
  */
-bool updateRefNumber(Property properties[], int propertyCount, int index) {
+bool updateRefNumber(const PropertyStore& store, Property& propertyToUpdate) {
     
     int newRefNumber = getValidNumericInput<int>((CYAN + getTranslatedString("PROMPT_NEW_REF_NUMBER") + RESET).c_str());
 
     
-    if (properties[index].refNumber == newRefNumber) {
+    if (propertyToUpdate.refNumber == newRefNumber) {
          cout << YELLOW << getTranslatedString("WARNING_VALUE_IDENTICAL") << RESET << endl;
         return false;
     }
 
     
-    if (getPropertyByRefNumber(newRefNumber, properties, propertyCount) != -1) {
+    if (getPropertyByRefNumber(newRefNumber, store) != -1) {
         cout << RED << getTranslatedString("ERROR_INVALID_OPERATION_REF_EXISTS") << RESET << endl;
         return false;
     }
 
-    properties[index].refNumber = newRefNumber; 
+    propertyToUpdate.refNumber = newRefNumber; 
     return true;
 }
 
@@ -221,10 +219,31 @@ bool updateStatus(Property& propertyToUpdate) {
     }
 
     
+    applyStatusChange(propertyToUpdate, newStatus);
     if (oldStatus == AVAILABLE && newStatus == RESERVED) {
-        propertyToUpdate.price *= 0.8; 
         cout << YELLOW << getTranslatedString("WARNING_PRICE_REDUCED_RESERVED") << RESET << endl;
     }
+    return true;
+}
+
+/**
+ * @brief Прилага нов статус към имот заедно с бизнес правилата за цената.
+ *
+ * При преминаване от НАЛИЧЕН към ЗАПАЗЕН цената се намалява с 20%. Функцията не взаимодейства
+ * с потребителя, затова се използва както от `updateStatus`, така и от пакетния режим.
+ *
+ * @param propertyToUpdate Имотът, чийто статус се променя.
+ * @param newStatus Новият статус.
+ * @return `true`, ако статусът е променен; `false`, ако е идентичен със стария.
+ */
+bool applyStatusChange(Property& propertyToUpdate, Status newStatus) {
+    if (propertyToUpdate.status == newStatus) {
+        return false;
+    }
+
+    if (propertyToUpdate.status == AVAILABLE && newStatus == RESERVED) {
+        propertyToUpdate.price *= 0.8; 
+    }
 
     propertyToUpdate.status = newStatus; 
     return true;
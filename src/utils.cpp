@@ -13,6 +13,7 @@
 #include <string> 
 #include <cctype> 
 #include <cstdlib> 
+#include <sys/stat.h> 
 #include "utils.h"
 #include "colors.h" 
 #include "localization.h" 
@@ -55,18 +56,21 @@ void printBanner() {
 /**
  * @brief Гарантира, че указаният път до директория съществува, създавайки я при необходимост.
  *
- * Тази функция използва shell командата `mkdir -p` за създаване на директории.
+ * Тази функция създава последователно всяка директория от пътя чрез системното извикване `mkdir`,
+ * без да стартира външна shell команда. Подобно на `mkdir -p`, родителските директории също се създават,
+ * ако не съществуват, и не се съобщава грешка, ако директорията вече съществува.
  * Тя е жизненоважна за настройване на необходимата файлова системна структура за съхранение на данни
  * (напр. файлове за възстановяване, логове), преди приложението да се опита да пише в тях.
- * Използването на `mkdir -p` гарантира, че родителските директории също се създават, ако не съществуват,
- * и не се съобщава грешка, ако директорията вече съществува.
  *
  * @param path C-стил низ, представляващ пътя до директорията за проверка/създаване.
  */
 void ensureDirectoryExists(const char* path) {
-    string command = "mkdir -p "; 
-    command += path;
-    system(command.c_str()); 
+    string current = path;
+    for (size_t i = 1; i <= current.size(); i++) {
+        if (i == current.size() || current[i] == '/') {
+            mkdir(current.substr(0, i).c_str(), 0755);
+        }
+    }
 }
 
 /**